@@ -10,11 +10,13 @@ ColumnLayout {
 
     function applyChangesToSettings() {
         options.showAxis = showAxisBox.checked
+        options.threadedRendering = threadedRenderingBox.checked
         options.storeIt();
     }
 
     function revertToOldSettings() {
         showAxisBox.checked = options.showAxis
+        threadedRenderingBox.checked = options.threadedRendering
     }
 
     Item {
@@ -43,6 +45,15 @@ ColumnLayout {
                 leftPadding: 0
             }
 
+            Label {
+                text: qsTr("Render on a separate thread (applies on restart)")
+            }
+            CheckBox {
+                id: threadedRenderingBox
+                checked: options.threadedRendering
+                leftPadding: 0
+            }
+
         }
     }
 }
@@ -0,0 +1,78 @@
+// Time the read and conversion of a file by the Assimp importer with one and with N threads,
+// then report the peak memory of the process.
+// Usage: BenchImporterThreads <file> [threads] [iterations]
+#include "vtkF3DAssimpImporter.h"
+
+#include <vtkNew.h>
+#include <vtkSMPTools.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Preload the file with a new importer, return the time spent in ms or a negative value
+double Preload(const std::string& fileName, int threads)
+{
+  vtkNew<vtkF3DAssimpImporter> importer;
+  importer->SetFileName(fileName);
+  importer->SetNumberOfThreads(threads);
+
+  auto start = std::chrono::steady_clock::now();
+  if (!importer->Preload())
+  {
+    return -1;
+  }
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+    .count();
+}
+}
+
+//----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " <file> [threads] [iterations]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::string fileName = argv[1];
+  int threads = argc > 2 ? std::max(1, std::atoi(argv[2]))
+                         : vtkSMPTools::GetEstimatedNumberOfThreads();
+  int iterations = argc > 3 ? std::max(1, std::atoi(argv[3])) : 5;
+
+  for (int nbThreads : { 1, threads })
+  {
+    std::vector<double> times;
+    for (int i = 0; i < iterations; i++)
+    {
+      double time = ::Preload(fileName, nbThreads);
+      if (time < 0)
+      {
+        std::cerr << "Cannot read " << fileName << std::endl;
+        return EXIT_FAILURE;
+      }
+      times.push_back(time);
+    }
+
+    std::sort(times.begin(), times.end());
+    std::cout << nbThreads << " thread(s): min " << times.front() << " ms, median "
+              << times[times.size() / 2] << " ms" << std::endl;
+  }
+
+#ifndef _WIN32
+  // kilobytes on Linux
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  std::cout << "peak RSS: " << usage.ru_maxrss / 1024 << " MiB" << std::endl;
+#endif
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,92 @@
+// Time the read of a file by the Assimp importer without and with its scene cache.
+// Usage: BenchSceneCache <file> [iterations]
+#include "F3DMeshCache.h"
+#include "vtkF3DAssimpImporter.h"
+
+#include <vtkNew.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Preload the file with a new importer, return the time spent in ms or a negative value
+double Preload(const std::string& fileName, const fs::path& cachePath)
+{
+  vtkNew<vtkF3DAssimpImporter> importer;
+  importer->SetFileName(fileName);
+  importer->SetCachePath(cachePath.string());
+
+  auto start = std::chrono::steady_clock::now();
+  if (!importer->Preload())
+  {
+    return -1;
+  }
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+    .count();
+}
+
+//----------------------------------------------------------------------------
+void Report(const std::string& name, std::vector<double>& times)
+{
+  std::sort(times.begin(), times.end());
+  std::cout << name << ": min " << times.front() << " ms, median " << times[times.size() / 2]
+            << " ms" << std::endl;
+}
+}
+
+//----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " <file> [iterations]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::string fileName = argv[1];
+  int iterations = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+
+  std::random_device random;
+  fs::path cachePath = fs::temp_directory_path() / ("BenchSceneCache-" + std::to_string(random()));
+
+  std::vector<double> cold;
+  std::vector<double> warm;
+  for (int i = 0; i < iterations; i++)
+  {
+    // cold, an empty cache directory, the write happens in the background
+    std::error_code ec;
+    fs::remove_all(cachePath, ec);
+    double time = ::Preload(fileName, cachePath);
+    F3DMeshCache::WaitForWrites();
+    if (time < 0)
+    {
+      std::cerr << "Cannot read " << fileName << std::endl;
+      return EXIT_FAILURE;
+    }
+    cold.push_back(time);
+
+    // warm, the cache file written by the cold read is mapped
+    time = ::Preload(fileName, cachePath);
+    if (time < 0)
+    {
+      std::cerr << "Cannot read the cache of " << fileName << std::endl;
+      return EXIT_FAILURE;
+    }
+    warm.push_back(time);
+  }
+
+  std::error_code ec;
+  fs::remove_all(cachePath, ec);
+
+  ::Report("cold", cold);
+  ::Report("warm", warm);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,1653 @@
+#include "F3DMeshCache.h"
+
+#include "F3DUtils.h"
+
+#include <vtkCellArray.h>
+#include <vtkDataArray.h>
+#include <vtkFieldData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkStringArray.h>
+#include <vtksys/Encoding.hxx>
+#include <vtksys/FStream.hxx>
+
+#include <assimp/scene.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+
+namespace
+{
+constexpr char FileMagic[8] = { 'F', '3', 'D', 'S', 'C', 'E', 'N', 'E' };
+constexpr char SourceMagic[8] = { 'F', '3', 'D', 'S', 'O', 'U', 'R', 'C' };
+constexpr std::uint32_t FileVersion = 3;
+constexpr std::uint16_t EndianCheck = 0x0102;
+constexpr std::streamoff Alignment = 16;
+constexpr std::size_t HashLength = 32;
+constexpr const char* SceneExtension = ".f3dscene";
+constexpr const char* SourceExtension = ".f3dsource";
+
+struct FileHeader
+{
+  char Magic[8];
+  std::uint32_t Version;
+  std::uint16_t Endian;
+  std::uint8_t IdTypeSize;
+  std::uint8_t RealSize;
+  std::uint64_t Stamp;
+  std::uint64_t SourceSize;
+  char Hash[HashLength];
+  std::uint64_t SceneSize;
+  std::uint64_t NumberOfMeshes;
+};
+
+// Header of the index file of a source, followed by its path
+struct SourceHeader
+{
+  char Magic[8];
+  std::uint32_t Version;
+  std::uint32_t PathLength;
+  std::uint64_t SourceSize;
+  std::int64_t SourceTime;
+  char Hash[HashLength];
+};
+
+struct MeshHeader
+{
+  std::uint64_t NumberOfArrays;
+  std::uint64_t Reserved;
+};
+
+enum Role : std::uint8_t
+{
+  POINTS,
+  POINT_DATA,
+  FIELD_DATA,
+  VERTS,
+  LINES,
+  POLYS
+};
+
+// For cells, Attribute is 0 for the offsets and 1 for the connectivity.
+// For point data, Attribute is the vtkDataSetAttributes type plus one, 0 if not an attribute.
+struct ArrayHeader
+{
+  std::uint8_t Role;
+  std::uint8_t Attribute;
+  std::uint16_t NameLength;
+  std::int32_t DataType;
+  std::int32_t NumberOfComponents;
+  std::uint32_t Reserved;
+  std::uint64_t NumberOfTuples;
+  std::uint64_t ByteSize;
+};
+
+struct ArrayEntry
+{
+  std::uint8_t Role;
+  std::uint8_t Attribute;
+  vtkAbstractArray* Array;
+};
+
+//----------------------------------------------------------------------------
+void WritePadding(std::ostream& out)
+{
+  static const char zeros[Alignment] = {};
+  std::streamoff remainder = static_cast<std::streamoff>(out.tellp()) % Alignment;
+  if (remainder != 0)
+  {
+    out.write(zeros, Alignment - remainder);
+  }
+}
+
+
+//----------------------------------------------------------------------------
+std::vector<ArrayEntry> CollectArrays(vtkPolyData* mesh)
+{
+  std::vector<ArrayEntry> entries;
+
+  if (mesh->GetPoints())
+  {
+    entries.push_back({ POINTS, 0, mesh->GetPoints()->GetData() });
+  }
+
+  vtkPointData* pointData = mesh->GetPointData();
+  for (int i = 0; i < pointData->GetNumberOfArrays(); i++)
+  {
+    int attribute = pointData->IsArrayAnAttribute(i);
+    entries.push_back(
+      { POINT_DATA, static_cast<std::uint8_t>(attribute + 1), pointData->GetAbstractArray(i) });
+  }
+
+  vtkFieldData* fieldData = mesh->GetFieldData();
+  for (int i = 0; i < fieldData->GetNumberOfArrays(); i++)
+  {
+    entries.push_back({ FIELD_DATA, 0, fieldData->GetAbstractArray(i) });
+  }
+
+  std::pair<Role, vtkCellArray*> cells[] = { { VERTS, mesh->GetVerts() },
+    { LINES, mesh->GetLines() }, { POLYS, mesh->GetPolys() } };
+  for (const auto& [role, cellArray] : cells)
+  {
+    if (cellArray && cellArray->GetNumberOfCells() > 0)
+    {
+      entries.push_back({ role, 0, cellArray->GetOffsetsArray() });
+      entries.push_back({ role, 1, cellArray->GetConnectivityArray() });
+    }
+  }
+
+  return entries;
+}
+
+//----------------------------------------------------------------------------
+bool WriteArray(std::ostream& out, const ArrayEntry& entry)
+{
+  vtkAbstractArray* array = entry.Array;
+  const char* name = array->GetName() ? array->GetName() : "";
+
+  ArrayHeader header = {};
+  header.Role = entry.Role;
+  header.Attribute = entry.Attribute;
+  header.NameLength = static_cast<std::uint16_t>(std::min<std::size_t>(std::strlen(name), 0xffff));
+  header.DataType = array->GetDataType();
+  header.NumberOfComponents = array->GetNumberOfComponents();
+  header.NumberOfTuples = static_cast<std::uint64_t>(array->GetNumberOfTuples());
+
+  vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
+  vtkStringArray* stringArray = vtkStringArray::SafeDownCast(array);
+  if (dataArray)
+  {
+    if (!dataArray->HasStandardMemoryLayout())
+    {
+      return false;
+    }
+    header.ByteSize =
+      static_cast<std::uint64_t>(dataArray->GetNumberOfValues()) * dataArray->GetDataTypeSize();
+  }
+  else if (stringArray)
+  {
+    for (vtkIdType i = 0; i < stringArray->GetNumberOfValues(); i++)
+    {
+      header.ByteSize += sizeof(std::uint32_t) + stringArray->GetValue(i).size();
+    }
+  }
+  else
+  {
+    return false;
+  }
+
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(name, header.NameLength);
+  WritePadding(out);
+
+  if (dataArray)
+  {
+    out.write(static_cast<const char*>(dataArray->GetVoidPointer(0)),
+      static_cast<std::streamsize>(header.ByteSize));
+  }
+  else
+  {
+    for (vtkIdType i = 0; i < stringArray->GetNumberOfValues(); i++)
+    {
+      const std::string& value = stringArray->GetValue(i);
+      std::uint32_t length = static_cast<std::uint32_t>(value.size());
+      out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+      out.write(value.data(), length);
+    }
+  }
+  WritePadding(out);
+
+  return out.good();
+}
+
+
+//----------------------------------------------------------------------------
+// A read only file mapped copy on write, so arrays wrapping it can be modified
+// without changing the file
+class MappedFile
+{
+public:
+  static std::shared_ptr<MappedFile> Open(const std::string& path)
+  {
+#ifdef _WIN32
+    HANDLE file = CreateFileW(vtksys::Encoding::ToWindowsExtendedPath(path).c_str(), GENERIC_READ,
+      FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+      return nullptr;
+    }
+    LARGE_INTEGER size;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    {
+      mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    }
+    CloseHandle(file);
+    if (!mapping)
+    {
+      return nullptr;
+    }
+    // the view keeps the mapping alive
+    void* view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view)
+    {
+      return nullptr;
+    }
+    return std::shared_ptr<MappedFile>(
+      new MappedFile(static_cast<char*>(view), static_cast<std::size_t>(size.QuadPart)));
+#else
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+      return nullptr;
+    }
+    struct stat status;
+    void* view = MAP_FAILED;
+    if (::fstat(file, &status) == 0 && status.st_size > 0)
+    {
+      view = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ | PROT_WRITE,
+        MAP_PRIVATE, file, 0);
+    }
+    ::close(file);
+    if (view == MAP_FAILED)
+    {
+      return nullptr;
+    }
+    return std::shared_ptr<MappedFile>(
+      new MappedFile(static_cast<char*>(view), static_cast<std::size_t>(status.st_size)));
+#endif
+  }
+
+  ~MappedFile()
+  {
+#ifdef _WIN32
+    UnmapViewOfFile(this->Data);
+#else
+    ::munmap(this->Data, this->Size);
+#endif
+  }
+
+  char* GetData() const
+  {
+    return this->Data;
+  }
+
+  std::size_t GetSize() const
+  {
+    return this->Size;
+  }
+
+private:
+  MappedFile(char* data, std::size_t size)
+    : Data(data)
+    , Size(size)
+  {
+  }
+  MappedFile(const MappedFile&) = delete;
+  void operator=(const MappedFile&) = delete;
+
+  char* Data;
+  std::size_t Size;
+};
+
+//----------------------------------------------------------------------------
+// Mapped files wrapped by VTK arrays, keyed by the wrapped values.
+// An entry is removed by the free function of the array buffer, so a file stays
+// mapped as long as an array, or a shallow copy of it, uses it.
+struct MappedArrays
+{
+  std::mutex Mutex;
+  std::unordered_map<const void*, std::shared_ptr<MappedFile>> Files;
+
+  static MappedArrays& GetInstance()
+  {
+    // never destroyed, arrays may be released during static destruction
+    static MappedArrays* instance = new MappedArrays();
+    return *instance;
+  }
+};
+
+//----------------------------------------------------------------------------
+void ReleaseMappedArray(void* values)
+{
+  MappedArrays& arrays = MappedArrays::GetInstance();
+  std::lock_guard<std::mutex> lock(arrays.Mutex);
+  arrays.Files.erase(values);
+}
+
+//----------------------------------------------------------------------------
+// Read values from a memory buffer, a mapped file or a part of it.
+// Sizes read from the buffer are checked against the remaining bytes before allocating,
+// any inconsistency marks the reader as failed
+class BufferReader
+{
+public:
+  BufferReader(const char* data, std::size_t size)
+    : Data(data)
+    , Size(size)
+  {
+  }
+
+  template<typename T>
+  T Read()
+  {
+    static_assert(std::is_arithmetic_v<T>);
+    T value = {};
+    this->ReadBytes(&value, sizeof(T));
+    return value;
+  }
+
+  void ReadBytes(void* data, std::size_t size)
+  {
+    const char* bytes = this->Skip(size);
+    if (bytes && size > 0)
+    {
+      std::memcpy(data, bytes, size);
+    }
+  }
+
+  // Skip size bytes, returns a pointer to them or nullptr if the buffer is too small
+  const char* Skip(std::size_t size)
+  {
+    if (this->Failed || size > this->GetRemaining())
+    {
+      this->Failed = true;
+      return nullptr;
+    }
+    const char* bytes = this->Data + this->Offset;
+    this->Offset += size;
+    return bytes;
+  }
+
+  void SkipPadding()
+  {
+    std::size_t remainder = this->Offset % static_cast<std::size_t>(Alignment);
+    if (remainder != 0)
+    {
+      this->Skip(static_cast<std::size_t>(Alignment) - remainder);
+    }
+  }
+
+  // Read a number of items each stored with at least itemSize bytes
+  unsigned int ReadCount(std::size_t itemSize)
+  {
+    std::uint32_t count = this->Read<std::uint32_t>();
+    if (this->Failed || count > this->GetRemaining() / std::max<std::size_t>(itemSize, 1))
+    {
+      this->Failed = true;
+      return 0;
+    }
+    return count;
+  }
+
+  void ReadString(aiString& value)
+  {
+    std::uint32_t length = this->Read<std::uint32_t>();
+    if (length >= sizeof(value.data))
+    {
+      this->Failed = true;
+      return;
+    }
+    this->ReadBytes(value.data, length);
+    value.length = this->Failed ? 0 : length;
+    value.data[value.length] = '\0';
+  }
+
+  void ReadVector(aiVector3D& value)
+  {
+    value.x = this->Read<ai_real>();
+    value.y = this->Read<ai_real>();
+    value.z = this->Read<ai_real>();
+  }
+
+  void ReadColor(aiColor3D& value)
+  {
+    value.r = this->Read<decltype(value.r)>();
+    value.g = this->Read<decltype(value.g)>();
+    value.b = this->Read<decltype(value.b)>();
+  }
+
+  void ReadMatrix(aiMatrix4x4& value)
+  {
+    for (unsigned int i = 0; i < 4; i++)
+    {
+      for (unsigned int j = 0; j < 4; j++)
+      {
+        value[i][j] = this->Read<ai_real>();
+      }
+    }
+  }
+
+  std::size_t GetOffset() const
+  {
+    return this->Offset;
+  }
+
+  std::size_t GetRemaining() const
+  {
+    return this->Size - this->Offset;
+  }
+
+  bool IsGood() const
+  {
+    return !this->Failed;
+  }
+
+  bool IsAtEnd() const
+  {
+    return this->Offset == this->Size;
+  }
+
+private:
+  const char* Data;
+  std::size_t Size;
+  std::size_t Offset = 0;
+  bool Failed = false;
+};
+
+//----------------------------------------------------------------------------
+// Create an array from the values found at the current offset of the reader in the file.
+// Numeric values are not copied, the array wraps the mapped file.
+vtkSmartPointer<vtkAbstractArray> ReadArray(
+  BufferReader& reader, const ArrayHeader& header, const std::shared_ptr<MappedFile>& file)
+{
+  // Do not trust sizes read from the file before allocating
+  if (header.ByteSize > reader.GetRemaining() || header.NumberOfComponents <= 0)
+  {
+    return nullptr;
+  }
+
+  vtkSmartPointer<vtkAbstractArray> array =
+    vtkSmartPointer<vtkAbstractArray>::Take(vtkAbstractArray::CreateArray(header.DataType));
+
+  vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
+  vtkStringArray* stringArray = vtkStringArray::SafeDownCast(array);
+  if (dataArray)
+  {
+    std::uint64_t nbValues = header.NumberOfTuples * header.NumberOfComponents;
+    if (nbValues * dataArray->GetDataTypeSize() != header.ByteSize)
+    {
+      return nullptr;
+    }
+    dataArray->SetNumberOfComponents(header.NumberOfComponents);
+    if (nbValues == 0)
+    {
+      return array;
+    }
+
+    char* values = file->GetData() + reader.GetOffset();
+    reader.Skip(header.ByteSize);
+    {
+      MappedArrays& arrays = MappedArrays::GetInstance();
+      std::lock_guard<std::mutex> lock(arrays.Mutex);
+      arrays.Files[values] = file;
+    }
+    dataArray->SetVoidArray(
+      values, static_cast<vtkIdType>(nbValues), 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+    dataArray->SetArrayFreeFunction(&ReleaseMappedArray);
+  }
+  else if (stringArray)
+  {
+    // Each value is at least stored with its length
+    if (header.NumberOfTuples * header.NumberOfComponents * sizeof(std::uint32_t) > header.ByteSize)
+    {
+      return nullptr;
+    }
+    stringArray->SetNumberOfComponents(header.NumberOfComponents);
+    stringArray->SetNumberOfTuples(static_cast<vtkIdType>(header.NumberOfTuples));
+
+    std::size_t end = reader.GetOffset() + header.ByteSize;
+    for (vtkIdType i = 0; i < stringArray->GetNumberOfValues(); i++)
+    {
+      std::uint32_t length = reader.Read<std::uint32_t>();
+      const char* value = reader.Skip(length);
+      if (!value || reader.GetOffset() > end)
+      {
+        return nullptr;
+      }
+      stringArray->SetValue(i, std::string(value, length));
+    }
+    if (reader.GetOffset() != end)
+    {
+      return nullptr;
+    }
+  }
+  else
+  {
+    return nullptr;
+  }
+
+  return reader.IsGood() ? array : nullptr;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> ReadPolyData(
+  BufferReader& reader, const std::shared_ptr<MappedFile>& file)
+{
+  MeshHeader meshHeader;
+  reader.ReadBytes(&meshHeader, sizeof(meshHeader));
+  if (!reader.IsGood() || meshHeader.NumberOfArrays > reader.GetRemaining() / sizeof(ArrayHeader))
+  {
+    return nullptr;
+  }
+
+  vtkNew<vtkPolyData> mesh;
+  vtkSmartPointer<vtkDataArray> cells[3][2];
+
+  for (std::uint64_t i = 0; i < meshHeader.NumberOfArrays; i++)
+  {
+    ArrayHeader header;
+    reader.ReadBytes(&header, sizeof(header));
+    const char* name = reader.Skip(header.NameLength);
+    reader.SkipPadding();
+    if (!reader.IsGood())
+    {
+      return nullptr;
+    }
+
+    vtkSmartPointer<vtkAbstractArray> array = ReadArray(reader, header, file);
+    reader.SkipPadding();
+    if (!array || !reader.IsGood())
+    {
+      return nullptr;
+    }
+    if (header.NameLength > 0)
+    {
+      array->SetName(std::string(name, header.NameLength).c_str());
+    }
+
+    vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
+    switch (header.Role)
+    {
+      case POINTS:
+      {
+        if (!dataArray || dataArray->GetNumberOfComponents() != 3)
+        {
+          return nullptr;
+        }
+        vtkNew<vtkPoints> points;
+        points->SetData(dataArray);
+        mesh->SetPoints(points);
+        break;
+      }
+      case POINT_DATA:
+      {
+        int index = mesh->GetPointData()->AddArray(array);
+        if (header.Attribute > 0)
+        {
+          mesh->GetPointData()->SetActiveAttribute(index, header.Attribute - 1);
+        }
+        break;
+      }
+      case FIELD_DATA:
+        mesh->GetFieldData()->AddArray(array);
+        break;
+      case VERTS:
+      case LINES:
+      case POLYS:
+        if (!dataArray || header.Attribute > 1)
+        {
+          return nullptr;
+        }
+        cells[header.Role - VERTS][header.Attribute] = dataArray;
+        break;
+      default:
+        return nullptr;
+    }
+  }
+
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  vtkCellArray* cellArrays[3] = { verts, lines, polys };
+  for (int i = 0; i < 3; i++)
+  {
+    if (cells[i][0] && cells[i][1] && !cellArrays[i]->SetData(cells[i][0], cells[i][1]))
+    {
+      return nullptr;
+    }
+  }
+  mesh->SetVerts(verts);
+  mesh->SetLines(lines);
+  mesh->SetPolys(polys);
+
+  return mesh;
+}
+
+//----------------------------------------------------------------------------
+// Serialize the parts of an Assimp scene used once its meshes are converted
+class SceneWriter
+{
+public:
+  template<typename T>
+  void Write(T value)
+  {
+    static_assert(std::is_arithmetic_v<T>);
+    this->WriteBytes(&value, sizeof(T));
+  }
+
+  void WriteBytes(const void* data, std::size_t size)
+  {
+    const char* bytes = static_cast<const char*>(data);
+    this->Buffer.insert(this->Buffer.end(), bytes, bytes + size);
+  }
+
+  void WriteString(const aiString& value)
+  {
+    this->Write<std::uint32_t>(value.length);
+    this->WriteBytes(value.data, value.length);
+  }
+
+  void WriteVector(const aiVector3D& value)
+  {
+    this->Write(value.x);
+    this->Write(value.y);
+    this->Write(value.z);
+  }
+
+  void WriteColor(const aiColor3D& value)
+  {
+    this->Write(value.r);
+    this->Write(value.g);
+    this->Write(value.b);
+  }
+
+  void WriteMatrix(const aiMatrix4x4& value)
+  {
+    for (unsigned int i = 0; i < 4; i++)
+    {
+      for (unsigned int j = 0; j < 4; j++)
+      {
+        this->Write(value[i][j]);
+      }
+    }
+  }
+
+  const std::vector<char>& GetBuffer() const
+  {
+    return this->Buffer;
+  }
+
+private:
+  std::vector<char> Buffer;
+};
+
+
+//----------------------------------------------------------------------------
+void WriteNode(SceneWriter& writer, const aiNode* node)
+{
+  writer.WriteString(node->mName);
+  writer.WriteMatrix(node->mTransformation);
+  writer.Write<std::uint32_t>(node->mNumMeshes);
+  for (unsigned int i = 0; i < node->mNumMeshes; i++)
+  {
+    writer.Write<std::uint32_t>(node->mMeshes[i]);
+  }
+  writer.Write<std::uint32_t>(node->mNumChildren);
+  for (unsigned int i = 0; i < node->mNumChildren; i++)
+  {
+    WriteNode(writer, node->mChildren[i]);
+  }
+}
+
+//----------------------------------------------------------------------------
+aiNode* ReadNode(BufferReader& reader, unsigned int nbMeshes)
+{
+  auto node = std::make_unique<aiNode>();
+  reader.ReadString(node->mName);
+  reader.ReadMatrix(node->mTransformation);
+
+  unsigned int count = reader.ReadCount(sizeof(std::uint32_t));
+  node->mMeshes = new unsigned int[count];
+  node->mNumMeshes = count;
+  for (unsigned int i = 0; i < count; i++)
+  {
+    node->mMeshes[i] = reader.Read<std::uint32_t>();
+    if (node->mMeshes[i] >= nbMeshes)
+    {
+      return nullptr;
+    }
+  }
+
+  count = reader.ReadCount(sizeof(std::uint32_t));
+  node->mChildren = new aiNode*[count]();
+  node->mNumChildren = count;
+  for (unsigned int i = 0; i < count; i++)
+  {
+    node->mChildren[i] = ReadNode(reader, nbMeshes);
+    if (!node->mChildren[i])
+    {
+      return nullptr;
+    }
+    node->mChildren[i]->mParent = node.get();
+  }
+
+  return reader.IsGood() ? node.release() : nullptr;
+}
+
+//----------------------------------------------------------------------------
+void WriteMaterial(SceneWriter& writer, const aiMaterial* material)
+{
+  writer.Write<std::uint32_t>(material->mNumProperties);
+  for (unsigned int i = 0; i < material->mNumProperties; i++)
+  {
+    const aiMaterialProperty* property = material->mProperties[i];
+    writer.WriteString(property->mKey);
+    writer.Write<std::uint32_t>(property->mSemantic);
+    writer.Write<std::uint32_t>(property->mIndex);
+    writer.Write<std::uint32_t>(property->mType);
+    writer.Write<std::uint32_t>(property->mDataLength);
+    writer.WriteBytes(property->mData, property->mDataLength);
+  }
+}
+
+//----------------------------------------------------------------------------
+aiMaterial* ReadMaterial(BufferReader& reader)
+{
+  auto material = std::make_unique<aiMaterial>();
+  unsigned int count = reader.ReadCount(5 * sizeof(std::uint32_t));
+  for (unsigned int i = 0; i < count && reader.IsGood(); i++)
+  {
+    aiString key;
+    reader.ReadString(key);
+    unsigned int semantic = reader.Read<std::uint32_t>();
+    unsigned int index = reader.Read<std::uint32_t>();
+    unsigned int type = reader.Read<std::uint32_t>();
+    std::vector<char> data(reader.ReadCount(1));
+    reader.ReadBytes(data.data(), data.size());
+    if (reader.IsGood())
+    {
+      material->AddBinaryProperty(data.data(), static_cast<unsigned int>(data.size()), key.C_Str(),
+        semantic, index, static_cast<aiPropertyTypeInfo>(type));
+    }
+  }
+  return reader.IsGood() ? material.release() : nullptr;
+}
+
+//----------------------------------------------------------------------------
+std::size_t GetTextureSize(const aiTexture* texture)
+{
+  // compressed textures store their size in bytes in mWidth
+  return texture->mHeight == 0
+    ? texture->mWidth
+    : static_cast<std::size_t>(texture->mWidth) * texture->mHeight * sizeof(aiTexel);
+}
+
+//----------------------------------------------------------------------------
+void WriteTexture(SceneWriter& writer, const aiTexture* texture)
+{
+  writer.Write<std::uint32_t>(texture->mWidth);
+  writer.Write<std::uint32_t>(texture->mHeight);
+  writer.WriteBytes(texture->achFormatHint, sizeof(texture->achFormatHint));
+  writer.WriteString(texture->mFilename);
+  writer.WriteBytes(texture->pcData, GetTextureSize(texture));
+}
+
+//----------------------------------------------------------------------------
+aiTexture* ReadTexture(BufferReader& reader)
+{
+  auto texture = std::make_unique<aiTexture>();
+  texture->mWidth = reader.Read<std::uint32_t>();
+  texture->mHeight = reader.Read<std::uint32_t>();
+  reader.ReadBytes(texture->achFormatHint, sizeof(texture->achFormatHint));
+  texture->achFormatHint[sizeof(texture->achFormatHint) - 1] = '\0';
+  reader.ReadString(texture->mFilename);
+
+  std::size_t size = GetTextureSize(texture.get());
+  if (!reader.IsGood() || size > reader.GetRemaining())
+  {
+    return nullptr;
+  }
+  texture->pcData = new aiTexel[(size + sizeof(aiTexel) - 1) / sizeof(aiTexel)];
+  reader.ReadBytes(texture->pcData, size);
+  return texture.release();
+}
+
+//----------------------------------------------------------------------------
+void WriteMesh(SceneWriter& writer, const aiMesh* mesh)
+{
+  writer.WriteString(mesh->mName);
+  writer.Write<std::uint32_t>(mesh->mMaterialIndex);
+  writer.Write<std::uint32_t>(mesh->mNumAnimMeshes);
+  writer.Write<std::uint32_t>(mesh->mNumBones);
+  for (unsigned int i = 0; i < mesh->mNumBones; i++)
+  {
+    const aiBone* bone = mesh->mBones[i];
+    writer.WriteString(bone->mName);
+    writer.Write<std::uint32_t>(bone->mNumWeights);
+    writer.WriteMatrix(bone->mOffsetMatrix);
+  }
+}
+
+//----------------------------------------------------------------------------
+aiMesh* ReadMesh(BufferReader& reader, unsigned int nbMaterials)
+{
+  auto mesh = std::make_unique<aiMesh>();
+  reader.ReadString(mesh->mName);
+  mesh->mMaterialIndex = reader.Read<std::uint32_t>();
+  if (mesh->mMaterialIndex >= nbMaterials)
+  {
+    return nullptr;
+  }
+
+  // targets are stored in the converted mesh, only their number is used
+  unsigned int count = reader.ReadCount(1);
+  mesh->mAnimMeshes = new aiAnimMesh*[count];
+  mesh->mNumAnimMeshes = count;
+  for (unsigned int i = 0; i < count; i++)
+  {
+    mesh->mAnimMeshes[i] = new aiAnimMesh();
+  }
+
+  // weights are stored in the converted mesh, only their number is used
+  count = reader.ReadCount(sizeof(std::uint32_t));
+  mesh->mBones = new aiBone*[count]();
+  mesh->mNumBones = count;
+  for (unsigned int i = 0; i < count && reader.IsGood(); i++)
+  {
+    aiBone* bone = new aiBone();
+    mesh->mBones[i] = bone;
+    reader.ReadString(bone->mName);
+    bone->mNumWeights = reader.Read<std::uint32_t>();
+    reader.ReadMatrix(bone->mOffsetMatrix);
+  }
+
+  return reader.IsGood() ? mesh.release() : nullptr;
+}
+
+//----------------------------------------------------------------------------
+void WriteCamera(SceneWriter& writer, const aiCamera* camera)
+{
+  writer.WriteString(camera->mName);
+  writer.WriteVector(camera->mPosition);
+  writer.WriteVector(camera->mUp);
+  writer.WriteVector(camera->mLookAt);
+  writer.Write(camera->mHorizontalFOV);
+  writer.Write(camera->mClipPlaneNear);
+  writer.Write(camera->mClipPlaneFar);
+  writer.Write(camera->mAspect);
+}
+
+//----------------------------------------------------------------------------
+aiCamera* ReadCamera(BufferReader& reader)
+{
+  auto camera = std::make_unique<aiCamera>();
+  reader.ReadString(camera->mName);
+  reader.ReadVector(camera->mPosition);
+  reader.ReadVector(camera->mUp);
+  reader.ReadVector(camera->mLookAt);
+  camera->mHorizontalFOV = reader.Read<decltype(camera->mHorizontalFOV)>();
+  camera->mClipPlaneNear = reader.Read<decltype(camera->mClipPlaneNear)>();
+  camera->mClipPlaneFar = reader.Read<decltype(camera->mClipPlaneFar)>();
+  camera->mAspect = reader.Read<decltype(camera->mAspect)>();
+  return reader.IsGood() ? camera.release() : nullptr;
+}
+
+//----------------------------------------------------------------------------
+void WriteLight(SceneWriter& writer, const aiLight* light)
+{
+  writer.WriteString(light->mName);
+  writer.Write<std::uint32_t>(light->mType);
+  writer.WriteVector(light->mPosition);
+  writer.WriteVector(light->mDirection);
+  writer.WriteVector(light->mUp);
+  writer.Write(light->mAttenuationConstant);
+  writer.Write(light->mAttenuationLinear);
+  writer.Write(light->mAttenuationQuadratic);
+  writer.WriteColor(light->mColorDiffuse);
+  writer.WriteColor(light->mColorSpecular);
+  writer.WriteColor(light->mColorAmbient);
+  writer.Write(light->mAngleInnerCone);
+  writer.Write(light->mAngleOuterCone);
+}
+
+//----------------------------------------------------------------------------
+aiLight* ReadLight(BufferReader& reader)
+{
+  auto light = std::make_unique<aiLight>();
+  reader.ReadString(light->mName);
+  light->mType = static_cast<aiLightSourceType>(reader.Read<std::uint32_t>());
+  reader.ReadVector(light->mPosition);
+  reader.ReadVector(light->mDirection);
+  reader.ReadVector(light->mUp);
+  light->mAttenuationConstant = reader.Read<decltype(light->mAttenuationConstant)>();
+  light->mAttenuationLinear = reader.Read<decltype(light->mAttenuationLinear)>();
+  light->mAttenuationQuadratic = reader.Read<decltype(light->mAttenuationQuadratic)>();
+  reader.ReadColor(light->mColorDiffuse);
+  reader.ReadColor(light->mColorSpecular);
+  reader.ReadColor(light->mColorAmbient);
+  light->mAngleInnerCone = reader.Read<decltype(light->mAngleInnerCone)>();
+  light->mAngleOuterCone = reader.Read<decltype(light->mAngleOuterCone)>();
+  return reader.IsGood() ? light.release() : nullptr;
+}
+
+//----------------------------------------------------------------------------
+void WriteAnimation(SceneWriter& writer, const aiAnimation* animation)
+{
+  writer.WriteString(animation->mName);
+  writer.Write(animation->mDuration);
+  writer.Write(animation->mTicksPerSecond);
+
+  writer.Write<std::uint32_t>(animation->mNumChannels);
+  for (unsigned int i = 0; i < animation->mNumChannels; i++)
+  {
+    const aiNodeAnim* channel = animation->mChannels[i];
+    writer.WriteString(channel->mNodeName);
+    writer.Write<std::uint32_t>(channel->mPreState);
+    writer.Write<std::uint32_t>(channel->mPostState);
+    writer.Write<std::uint32_t>(channel->mNumPositionKeys);
+    for (unsigned int k = 0; k < channel->mNumPositionKeys; k++)
+    {
+      writer.Write(channel->mPositionKeys[k].mTime);
+      writer.WriteVector(channel->mPositionKeys[k].mValue);
+    }
+    writer.Write<std::uint32_t>(channel->mNumRotationKeys);
+    for (unsigned int k = 0; k < channel->mNumRotationKeys; k++)
+    {
+      const aiQuaternion& rotation = channel->mRotationKeys[k].mValue;
+      writer.Write(channel->mRotationKeys[k].mTime);
+      writer.Write(rotation.w);
+      writer.Write(rotation.x);
+      writer.Write(rotation.y);
+      writer.Write(rotation.z);
+    }
+    writer.Write<std::uint32_t>(channel->mNumScalingKeys);
+    for (unsigned int k = 0; k < channel->mNumScalingKeys; k++)
+    {
+      writer.Write(channel->mScalingKeys[k].mTime);
+      writer.WriteVector(channel->mScalingKeys[k].mValue);
+    }
+  }
+
+  writer.Write<std::uint32_t>(animation->mNumMorphMeshChannels);
+  for (unsigned int i = 0; i < animation->mNumMorphMeshChannels; i++)
+  {
+    const aiMeshMorphAnim* channel = animation->mMorphMeshChannels[i];
+    writer.WriteString(channel->mName);
+    writer.Write<std::uint32_t>(channel->mNumKeys);
+    for (unsigned int k = 0; k < channel->mNumKeys; k++)
+    {
+      const aiMeshMorphKey& key = channel->mKeys[k];
+      writer.Write(key.mTime);
+      writer.Write<std::uint32_t>(key.mNumValuesAndWeights);
+      for (unsigned int v = 0; v < key.mNumValuesAndWeights; v++)
+      {
+        writer.Write<std::uint32_t>(key.mValues[v]);
+        writer.Write(key.mWeights[v]);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+aiAnimation* ReadAnimation(BufferReader& reader)
+{
+  constexpr std::size_t vectorKeySize = sizeof(double) + 3 * sizeof(ai_real);
+  constexpr std::size_t quatKeySize = sizeof(double) + 4 * sizeof(ai_real);
+
+  auto animation = std::make_unique<aiAnimation>();
+  reader.ReadString(animation->mName);
+  animation->mDuration = reader.Read<double>();
+  animation->mTicksPerSecond = reader.Read<double>();
+
+  unsigned int count = reader.ReadCount(4 * sizeof(std::uint32_t));
+  animation->mChannels = new aiNodeAnim*[count]();
+  animation->mNumChannels = count;
+  for (unsigned int i = 0; i < count && reader.IsGood(); i++)
+  {
+    aiNodeAnim* channel = new aiNodeAnim();
+    animation->mChannels[i] = channel;
+    reader.ReadString(channel->mNodeName);
+    channel->mPreState = static_cast<aiAnimBehaviour>(reader.Read<std::uint32_t>());
+    channel->mPostState = static_cast<aiAnimBehaviour>(reader.Read<std::uint32_t>());
+
+    unsigned int nbKeys = reader.ReadCount(vectorKeySize);
+    channel->mPositionKeys = new aiVectorKey[nbKeys];
+    channel->mNumPositionKeys = nbKeys;
+    for (unsigned int k = 0; k < nbKeys; k++)
+    {
+      channel->mPositionKeys[k].mTime = reader.Read<double>();
+      reader.ReadVector(channel->mPositionKeys[k].mValue);
+    }
+
+    nbKeys = reader.ReadCount(quatKeySize);
+    channel->mRotationKeys = new aiQuatKey[nbKeys];
+    channel->mNumRotationKeys = nbKeys;
+    for (unsigned int k = 0; k < nbKeys; k++)
+    {
+      aiQuaternion& rotation = channel->mRotationKeys[k].mValue;
+      channel->mRotationKeys[k].mTime = reader.Read<double>();
+      rotation.w = reader.Read<ai_real>();
+      rotation.x = reader.Read<ai_real>();
+      rotation.y = reader.Read<ai_real>();
+      rotation.z = reader.Read<ai_real>();
+    }
+
+    nbKeys = reader.ReadCount(vectorKeySize);
+    channel->mScalingKeys = new aiVectorKey[nbKeys];
+    channel->mNumScalingKeys = nbKeys;
+    for (unsigned int k = 0; k < nbKeys; k++)
+    {
+      channel->mScalingKeys[k].mTime = reader.Read<double>();
+      reader.ReadVector(channel->mScalingKeys[k].mValue);
+    }
+  }
+
+  count = reader.ReadCount(2 * sizeof(std::uint32_t));
+  animation->mMorphMeshChannels = new aiMeshMorphAnim*[count]();
+  animation->mNumMorphMeshChannels = count;
+  for (unsigned int i = 0; i < count && reader.IsGood(); i++)
+  {
+    aiMeshMorphAnim* channel = new aiMeshMorphAnim();
+    animation->mMorphMeshChannels[i] = channel;
+    reader.ReadString(channel->mName);
+
+    unsigned int nbKeys = reader.ReadCount(sizeof(double) + sizeof(std::uint32_t));
+    channel->mKeys = new aiMeshMorphKey[nbKeys];
+    channel->mNumKeys = nbKeys;
+    for (unsigned int k = 0; k < nbKeys && reader.IsGood(); k++)
+    {
+      aiMeshMorphKey& key = channel->mKeys[k];
+      key.mTime = reader.Read<double>();
+      unsigned int nbValues = reader.ReadCount(sizeof(std::uint32_t) + sizeof(double));
+      key.mValues = new unsigned int[nbValues];
+      key.mWeights = new double[nbValues];
+      key.mNumValuesAndWeights = nbValues;
+      for (unsigned int v = 0; v < nbValues; v++)
+      {
+        key.mValues[v] = reader.Read<std::uint32_t>();
+        key.mWeights[v] = reader.Read<double>();
+      }
+    }
+  }
+
+  return reader.IsGood() ? animation.release() : nullptr;
+}
+
+//----------------------------------------------------------------------------
+std::vector<char> SerializeScene(const aiScene* scene)
+{
+  SceneWriter writer;
+  writer.Write<std::uint32_t>(scene->mFlags);
+
+  // materials and meshes come first, so indices referring to them can be checked when read
+  writer.Write<std::uint32_t>(scene->mNumMaterials);
+  for (unsigned int i = 0; i < scene->mNumMaterials; i++)
+  {
+    WriteMaterial(writer, scene->mMaterials[i]);
+  }
+  writer.Write<std::uint32_t>(scene->mNumMeshes);
+  for (unsigned int i = 0; i < scene->mNumMeshes; i++)
+  {
+    WriteMesh(writer, scene->mMeshes[i]);
+  }
+  writer.Write<std::uint32_t>(scene->mNumTextures);
+  for (unsigned int i = 0; i < scene->mNumTextures; i++)
+  {
+    WriteTexture(writer, scene->mTextures[i]);
+  }
+
+  writer.Write<std::uint8_t>(scene->mRootNode != nullptr);
+  if (scene->mRootNode)
+  {
+    WriteNode(writer, scene->mRootNode);
+  }
+
+  writer.Write<std::uint32_t>(scene->mNumCameras);
+  for (unsigned int i = 0; i < scene->mNumCameras; i++)
+  {
+    WriteCamera(writer, scene->mCameras[i]);
+  }
+  writer.Write<std::uint32_t>(scene->mNumLights);
+  for (unsigned int i = 0; i < scene->mNumLights; i++)
+  {
+    WriteLight(writer, scene->mLights[i]);
+  }
+  writer.Write<std::uint32_t>(scene->mNumAnimations);
+  for (unsigned int i = 0; i < scene->mNumAnimations; i++)
+  {
+    WriteAnimation(writer, scene->mAnimations[i]);
+  }
+
+  return writer.GetBuffer();
+}
+
+//----------------------------------------------------------------------------
+// Read a list of scene items, the scene owns the array before it is filled so it
+// releases what has been read if an item fails
+template<typename T, typename ReadItem>
+bool ReadSceneItems(BufferReader& reader, T**& items, unsigned int& nbItems, ReadItem&& readItem)
+{
+  unsigned int count = reader.ReadCount(sizeof(std::uint32_t));
+  items = new T*[count]();
+  nbItems = count;
+  for (unsigned int i = 0; i < count; i++)
+  {
+    items[i] = readItem();
+    if (!items[i])
+    {
+      return false;
+    }
+  }
+  return reader.IsGood();
+}
+
+//----------------------------------------------------------------------------
+std::unique_ptr<aiScene> DeserializeScene(const char* data, std::size_t size)
+{
+  BufferReader reader(data, size);
+  auto scene = std::make_unique<aiScene>();
+  scene->mFlags = reader.Read<std::uint32_t>();
+
+  if (!ReadSceneItems(reader, scene->mMaterials, scene->mNumMaterials,
+        [&]() { return ReadMaterial(reader); }) ||
+    !ReadSceneItems(reader, scene->mMeshes, scene->mNumMeshes,
+      [&]() { return ReadMesh(reader, scene->mNumMaterials); }) ||
+    !ReadSceneItems(
+      reader, scene->mTextures, scene->mNumTextures, [&]() { return ReadTexture(reader); }))
+  {
+    return nullptr;
+  }
+
+  if (reader.Read<std::uint8_t>())
+  {
+    scene->mRootNode = ReadNode(reader, scene->mNumMeshes);
+    if (!scene->mRootNode)
+    {
+      return nullptr;
+    }
+  }
+
+  if (!ReadSceneItems(
+        reader, scene->mCameras, scene->mNumCameras, [&]() { return ReadCamera(reader); }) ||
+    !ReadSceneItems(
+      reader, scene->mLights, scene->mNumLights, [&]() { return ReadLight(reader); }) ||
+    !ReadSceneItems(reader, scene->mAnimations, scene->mNumAnimations,
+      [&]() { return ReadAnimation(reader); }))
+  {
+    return nullptr;
+  }
+
+  if (!reader.IsAtEnd())
+  {
+    return nullptr;
+  }
+  return scene;
+}
+
+//----------------------------------------------------------------------------
+// FNV-1a, stable across runs and platforms unlike std::hash
+std::uint64_t HashString(const std::string& value)
+{
+  std::uint64_t hash = 0xcbf29ce484222325ull;
+  for (char c : value)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+//----------------------------------------------------------------------------
+// Write a file next to its final location, then rename it,
+// so a concurrent reader never sees a partial file
+template<typename WriteContent>
+bool WriteAtomically(const std::string& path, WriteContent&& writeContent)
+{
+  namespace fs = std::filesystem;
+
+  std::random_device random;
+  fs::path tmpPath = path + "." + std::to_string(random()) + ".tmp";
+
+  bool success = false;
+  {
+    vtksys::ofstream out(tmpPath.string().c_str(), std::ios_base::binary | std::ios_base::trunc);
+    if (!out.is_open())
+    {
+      return false;
+    }
+    success = writeContent(out) && out.good();
+  }
+
+  std::error_code ec;
+  if (success)
+  {
+    fs::rename(tmpPath, path, ec);
+    success = !ec;
+  }
+  if (!success)
+  {
+    fs::remove(tmpPath, ec);
+  }
+  return success;
+}
+
+//----------------------------------------------------------------------------
+bool WriteSceneFile(const std::string& path, const F3DMeshCache::Key& key,
+  const std::vector<char>& sceneBlock, const std::vector<vtkSmartPointer<vtkPolyData>>& meshes)
+{
+  if (key.Hash.size() != HashLength)
+  {
+    return false;
+  }
+
+  return WriteAtomically(path,
+    [&](std::ostream& out)
+    {
+      FileHeader header = {};
+      std::memcpy(header.Magic, FileMagic, sizeof(FileMagic));
+      header.Version = FileVersion;
+      header.Endian = EndianCheck;
+      header.IdTypeSize = sizeof(vtkIdType);
+      header.RealSize = sizeof(ai_real);
+      header.Stamp = key.Stamp;
+      header.SourceSize = key.SourceSize;
+      std::memcpy(header.Hash, key.Hash.data(), HashLength);
+      header.SceneSize = sceneBlock.size();
+      header.NumberOfMeshes = meshes.size();
+      out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      out.write(sceneBlock.data(), static_cast<std::streamsize>(sceneBlock.size()));
+      WritePadding(out);
+
+      bool success = out.good();
+      for (const vtkSmartPointer<vtkPolyData>& mesh : meshes)
+      {
+        if (!success || !mesh)
+        {
+          return false;
+        }
+
+        std::vector<ArrayEntry> entries = CollectArrays(mesh);
+
+        MeshHeader meshHeader = {};
+        meshHeader.NumberOfArrays = entries.size();
+        out.write(reinterpret_cast<const char*>(&meshHeader), sizeof(meshHeader));
+
+        for (const ArrayEntry& entry : entries)
+        {
+          success = success && WriteArray(out, entry);
+        }
+      }
+      return success;
+    });
+}
+
+//----------------------------------------------------------------------------
+std::string GetSourceIndexFile(const std::string& directory, const std::string& sourcePath)
+{
+  char name[17];
+  std::snprintf(
+    name, sizeof(name), "%016llx", static_cast<unsigned long long>(HashString(sourcePath)));
+  return (std::filesystem::path(directory) / (std::string(name) + SourceExtension)).string();
+}
+
+//----------------------------------------------------------------------------
+// Get the hash stored in the index file of a source, if it is up to date
+bool ReadSourceIndex(const std::string& indexPath, const std::string& sourcePath,
+  std::uint64_t sourceSize, std::int64_t sourceTime, std::string& hash)
+{
+  vtksys::ifstream in(indexPath.c_str(), std::ios_base::binary);
+  if (!in.is_open())
+  {
+    return false;
+  }
+
+  SourceHeader header;
+  in.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!in || std::memcmp(header.Magic, SourceMagic, sizeof(SourceMagic)) != 0 ||
+    header.Version != FileVersion || header.SourceSize != sourceSize ||
+    header.SourceTime != sourceTime || header.PathLength != sourcePath.size())
+  {
+    return false;
+  }
+
+  // the file name is a hash of the path, make sure it is not another source
+  std::string path(header.PathLength, '\0');
+  in.read(path.data(), static_cast<std::streamsize>(path.size()));
+  if (!in || path != sourcePath)
+  {
+    return false;
+  }
+
+  hash.assign(header.Hash, HashLength);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool WriteSourceIndex(const std::string& indexPath, const std::string& sourcePath,
+  std::uint64_t sourceSize, std::int64_t sourceTime, const std::string& hash)
+{
+  return WriteAtomically(indexPath,
+    [&](std::ostream& out)
+    {
+      SourceHeader header = {};
+      std::memcpy(header.Magic, SourceMagic, sizeof(SourceMagic));
+      header.Version = FileVersion;
+      header.PathLength = static_cast<std::uint32_t>(sourcePath.size());
+      header.SourceSize = sourceSize;
+      header.SourceTime = sourceTime;
+      std::memcpy(header.Hash, hash.data(), HashLength);
+      out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      out.write(sourcePath.data(), static_cast<std::streamsize>(sourcePath.size()));
+      return true;
+    });
+}
+
+//----------------------------------------------------------------------------
+// A single thread writing cache files in the order they are queued.
+// Remaining writes are completed before the process exits.
+class BackgroundWriter
+{
+public:
+  static BackgroundWriter& GetInstance()
+  {
+    static BackgroundWriter instance;
+    return instance;
+  }
+
+  ~BackgroundWriter()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Stopping = true;
+    }
+    this->Condition.notify_all();
+    if (this->Worker.joinable())
+    {
+      this->Worker.join();
+    }
+  }
+
+  // Queue a task writing the file at path, does nothing if it is already queued
+  void Enqueue(const std::string& path, std::function<void()> task)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      if (!this->Pending.insert(path).second)
+      {
+        return;
+      }
+      this->Queue.emplace_back(path, std::move(task));
+
+      if (!this->Worker.joinable())
+      {
+        this->Worker = std::thread([this]() { this->Run(); });
+      }
+    }
+    this->Condition.notify_all();
+  }
+
+  void Wait()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Condition.wait(lock, [this]() { return this->Pending.empty(); });
+  }
+
+private:
+  BackgroundWriter() = default;
+  BackgroundWriter(const BackgroundWriter&) = delete;
+  void operator=(const BackgroundWriter&) = delete;
+
+  void Run()
+  {
+    for (;;)
+    {
+      std::pair<std::string, std::function<void()>> work;
+      {
+        std::unique_lock<std::mutex> lock(this->Mutex);
+        this->Condition.wait(lock, [this]() { return this->Stopping || !this->Queue.empty(); });
+
+        // Remaining tasks are processed before stopping
+        if (this->Queue.empty())
+        {
+          return;
+        }
+        work = std::move(this->Queue.front());
+        this->Queue.pop_front();
+      }
+
+      work.second();
+
+      {
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        this->Pending.erase(work.first);
+      }
+      this->Condition.notify_all();
+    }
+  }
+
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::deque<std::pair<std::string, std::function<void()>>> Queue;
+  std::set<std::string> Pending; // queued or being written
+  std::thread Worker;
+  bool Stopping = false;
+};
+}
+
+//----------------------------------------------------------------------------
+bool F3DMeshCache::GetKey(
+  const std::string& directory, const std::string& sourcePath, std::uint64_t stamp, Key& key)
+{
+  namespace fs = std::filesystem;
+
+  std::error_code ec;
+  std::string absolutePath = fs::absolute(sourcePath, ec).lexically_normal().string();
+  if (ec)
+  {
+    return false;
+  }
+  std::uint64_t size = fs::file_size(absolutePath, ec);
+  if (ec)
+  {
+    return false;
+  }
+  std::int64_t time =
+    static_cast<std::int64_t>(fs::last_write_time(absolutePath, ec).time_since_epoch().count());
+  if (ec)
+  {
+    return false;
+  }
+
+  // hashing a large file takes time, only do it again when the source changes
+  std::string indexPath = ::GetSourceIndexFile(directory, absolutePath);
+  std::string hash;
+  if (::ReadSourceIndex(indexPath, absolutePath, size, time, hash))
+  {
+    fs::last_write_time(indexPath, fs::file_time_type::clock::now(), ec);
+  }
+  else
+  {
+    hash = F3DUtils::ComputeFileHash(absolutePath);
+    if (hash.size() != HashLength)
+    {
+      return false;
+    }
+    fs::create_directories(directory, ec);
+    ::WriteSourceIndex(indexPath, absolutePath, size, time, hash);
+  }
+
+  key.Hash = hash;
+  key.SourceSize = size;
+  key.Stamp = stamp;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+std::string F3DMeshCache::GetCacheFile(const std::string& directory, const Key& key)
+{
+  return (std::filesystem::path(directory) / (key.Hash + ::SceneExtension)).string();
+}
+
+//----------------------------------------------------------------------------
+bool F3DMeshCache::Write(const std::string& path, const Key& key, const aiScene* scene,
+  const std::vector<vtkSmartPointer<vtkPolyData>>& meshes)
+{
+  if (!scene || meshes.size() != scene->mNumMeshes)
+  {
+    return false;
+  }
+  return ::WriteSceneFile(path, key, ::SerializeScene(scene), meshes);
+}
+
+//----------------------------------------------------------------------------
+void F3DMeshCache::WriteInBackground(const std::string& path, const Key& key,
+  const aiScene* scene, const std::vector<vtkSmartPointer<vtkPolyData>>& meshes,
+  std::uint64_t budget)
+{
+  if (!scene || meshes.size() != scene->mNumMeshes)
+  {
+    return;
+  }
+
+  // the scene is not owned, serialize it now
+  std::vector<char> sceneBlock = ::SerializeScene(scene);
+  ::BackgroundWriter::GetInstance().Enqueue(path,
+    [path, key, sceneBlock = std::move(sceneBlock), meshes, budget]()
+    {
+      if (::WriteSceneFile(path, key, sceneBlock, meshes))
+      {
+        F3DMeshCache::Trim(std::filesystem::path(path).parent_path().string(), budget);
+      }
+    });
+}
+
+//----------------------------------------------------------------------------
+void F3DMeshCache::WaitForWrites()
+{
+  ::BackgroundWriter::GetInstance().Wait();
+}
+
+//----------------------------------------------------------------------------
+std::unique_ptr<aiScene> F3DMeshCache::Read(
+  const std::string& path, const Key& key, std::vector<vtkSmartPointer<vtkPolyData>>& meshes)
+{
+  meshes.clear();
+
+  std::shared_ptr<MappedFile> file = MappedFile::Open(path);
+  if (!file)
+  {
+    return nullptr;
+  }
+  BufferReader reader(file->GetData(), file->GetSize());
+
+  FileHeader header;
+  reader.ReadBytes(&header, sizeof(header));
+  if (!reader.IsGood() || std::memcmp(header.Magic, FileMagic, sizeof(FileMagic)) != 0 ||
+    header.Version != FileVersion || header.Endian != EndianCheck ||
+    header.IdTypeSize != sizeof(vtkIdType) || header.RealSize != sizeof(ai_real) ||
+    header.Stamp != key.Stamp || header.SourceSize != key.SourceSize ||
+    key.Hash.size() != HashLength || std::memcmp(header.Hash, key.Hash.data(), HashLength) != 0 ||
+    header.SceneSize > reader.GetRemaining() ||
+    header.NumberOfMeshes > reader.GetRemaining() / sizeof(MeshHeader))
+  {
+    return nullptr;
+  }
+
+  const char* sceneBlock = reader.Skip(header.SceneSize);
+  reader.SkipPadding();
+  if (!reader.IsGood())
+  {
+    return nullptr;
+  }
+  std::unique_ptr<aiScene> scene = ::DeserializeScene(sceneBlock, header.SceneSize);
+  if (!scene || scene->mNumMeshes != header.NumberOfMeshes)
+  {
+    return nullptr;
+  }
+
+  meshes.reserve(header.NumberOfMeshes);
+  for (std::uint64_t i = 0; i < header.NumberOfMeshes; i++)
+  {
+    vtkSmartPointer<vtkPolyData> mesh = ::ReadPolyData(reader, file);
+    if (!mesh)
+    {
+      meshes.clear();
+      return nullptr;
+    }
+    meshes.push_back(mesh);
+  }
+
+  // the modification time of cache files is their last use, see Trim
+  std::error_code ec;
+  std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+  return scene;
+}
+
+//----------------------------------------------------------------------------
+void F3DMeshCache::Trim(const std::string& directory, std::uint64_t budget)
+{
+  namespace fs = std::filesystem;
+
+  struct Entry
+  {
+    fs::file_time_type Time;
+    std::uint64_t Size;
+    fs::path Path;
+  };
+  std::vector<Entry> entries;
+  std::uint64_t total = 0;
+
+  std::error_code ec;
+  for (const fs::directory_entry& file : fs::directory_iterator(directory, ec))
+  {
+    std::error_code fileEc;
+    fs::path extension = file.path().extension();
+    if (!file.is_regular_file(fileEc) ||
+      (extension != ::SceneExtension && extension != ::SourceExtension))
+    {
+      continue;
+    }
+    Entry entry{ file.last_write_time(fileEc), file.file_size(fileEc), file.path() };
+    if (!fileEc)
+    {
+      total += entry.Size;
+      entries.emplace_back(std::move(entry));
+    }
+  }
+  if (total <= budget)
+  {
+    return;
+  }
+
+  // a removed index only means hashing its source again
+  std::sort(entries.begin(), entries.end(),
+    [](const Entry& a, const Entry& b) { return a.Time < b.Time; });
+  for (const Entry& entry : entries)
+  {
+    if (total <= budget)
+    {
+      break;
+    }
+    // fails on Windows while the file is mapped, it is kept in that case
+    if (fs::remove(entry.Path, ec))
+    {
+      total -= entry.Size;
+    }
+  }
+}
@@ -0,0 +1,71 @@
+/**
+ * @namespace F3DMeshCache
+{
+/*
+ * Identify the content of a source file and the settings used to convert it.
+ * A cached scene is only used if all of them match.
+ */
+struct Key
+{
+  std::string Hash;
+  std::uint64_t SourceSize = 0;
+  std::uint64_t Stamp = 0;
+};
+
+/*
+ * Get the key of a source file, hash being the MD5 of its content.
+ * The hash is stored in a small index file of the directory named after the source path,
+ * and only computed again when the size or modification time of the source changes.
+ * stamp is an arbitrary value identifying the conversion settings.
+ * Returns false if the file cannot be read.
+ */
+bool GetKey(
+  const std::string& directory, const std::string& sourcePath, std::uint64_t stamp, Key& key);
+
+/*
+ * Get the path of the cache file of a source in the directory.
+ * The name only depends on the content hash, identical files share their entry.
+ */
+std::string GetCacheFile(const std::string& directory, const Key& key);
+
+/*
+ * Write the scene and its converted meshes into the file at path.
+ * The file is written next to its final location and then renamed,
+ * so a concurrent reader never sees a partial file.
+ * Returns true on success.
+ */
+bool Write(const std::string& path, const Key& key, const aiScene* scene,
+  const std::vector<vtkSmartPointer<vtkPolyData>>& meshes);
+
+/*
+ * Same as Write, but on a background thread, then Trim the directory of path to budget.
+ * The scene is serialized before returning, the meshes are only read on the background
+ * thread and must not be modified afterwards.
+ * Nothing is done if the same file is already being written.
+ */
+void WriteInBackground(const std::string& path, const Key& key, const aiScene* scene,
+  const std::vector<vtkSmartPointer<vtkPolyData>>& meshes, std::uint64_t budget);
+
+/*
+ * Wait for the files written in background to be done
+ */
+void WaitForWrites();
+
+/*
+ * Read a scene and its converted meshes from the file at path.
+ * The file is mapped in memory and stays mapped as long as an array of the meshes uses it.
+ * The file is marked as recently used, see Trim.
+ * Returns nullptr if the file does not exist, is corrupted or was written
+ * for another key, meshes is left empty in that case.
+ */
+std::unique_ptr<aiScene> Read(
+  const std::string& path, const Key& key, std::vector<vtkSmartPointer<vtkPolyData>>& meshes);
+
+/*
+ * Remove the least recently used cache and index files of the directory
+ * until their total size is below budget, in bytes.
+ */
+void Trim(const std::string& directory, std::uint64_t budget);
+};
+
+#endif
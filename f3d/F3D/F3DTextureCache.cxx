@@ -0,0 +1,179 @@
+#include "F3DTextureCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+
+//----------------------------------------------------------------------------
+F3DTextureCache& F3DTextureCache::GetInstance()
+{
+  static F3DTextureCache instance;
+  return instance;
+}
+
+//----------------------------------------------------------------------------
+F3DTextureCache::~F3DTextureCache()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->QueueMutex);
+    this->Stopping = true;
+  }
+  this->QueueCondition.notify_all();
+  for (std::thread& worker : this->Workers)
+  {
+    worker.join();
+  }
+}
+
+//----------------------------------------------------------------------------
+F3DTextureCache::ImageFuture F3DTextureCache::Request(
+  const std::string& path, vtkImageReader2* reader, bool& hit)
+{
+  std::error_code ec;
+  std::uintmax_t fileSize = std::filesystem::file_size(path, ec);
+  std::int64_t fileTime = 0;
+  if (!ec)
+  {
+    fileTime = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+  }
+
+  std::lock_guard<std::mutex> lock(this->Mutex);
+
+  auto it = this->Entries.find(path);
+  if (it != this->Entries.end() && it->second.FileSize == fileSize &&
+    it->second.FileTime == fileTime)
+  {
+    it->second.LastUse = ++this->UseCounter;
+    hit = true;
+    return it->second.Image;
+  }
+  hit = false;
+
+  auto promise = std::make_shared<std::promise<vtkSmartPointer<vtkImageData>>>();
+
+  Entry& entry = this->Entries[path];
+  entry.FileSize = fileSize;
+  entry.FileTime = fileTime;
+  entry.LastUse = ++this->UseCounter;
+  entry.Image = promise->get_future().share();
+
+  vtkSmartPointer<vtkImageReader2> decoder = reader;
+  this->Enqueue(
+    [decoder, promise]()
+    {
+      decoder->Update();
+
+      // Detach the image from the reader pipeline so the reader can be released
+      vtkSmartPointer<vtkImageData> image;
+      vtkImageData* output = decoder->GetOutput();
+      if (output && output->GetNumberOfPoints() > 0)
+      {
+        image = vtkSmartPointer<vtkImageData>::New();
+        image->ShallowCopy(output);
+      }
+      promise->set_value(image);
+    });
+
+  this->Evict();
+
+  return entry.Image;
+}
+
+//----------------------------------------------------------------------------
+void F3DTextureCache::SetMaximumSize(std::uintmax_t size)
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  this->MaximumSize = size;
+  this->Evict();
+}
+
+//----------------------------------------------------------------------------
+void F3DTextureCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  this->Entries.clear();
+}
+
+//----------------------------------------------------------------------------
+void F3DTextureCache::Enqueue(std::function<void()> task)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->QueueMutex);
+    this->Queue.emplace_back(std::move(task));
+
+    if (this->Workers.empty())
+    {
+      unsigned int nbWorkers = std::max(1u, std::thread::hardware_concurrency() / 2);
+      for (unsigned int i = 0; i < nbWorkers; i++)
+      {
+        this->Workers.emplace_back(
+          [this]()
+          {
+            for (;;)
+            {
+              std::function<void()> work;
+              {
+                std::unique_lock<std::mutex> queueLock(this->QueueMutex);
+                this->QueueCondition.wait(
+                  queueLock, [this]() { return this->Stopping || !this->Queue.empty(); });
+
+                // Remaining tasks are processed before stopping
+                if (this->Queue.empty())
+                {
+                  return;
+                }
+                work = std::move(this->Queue.front());
+                this->Queue.pop_front();
+              }
+              work();
+            }
+          });
+      }
+    }
+  }
+  this->QueueCondition.notify_one();
+}
+
+//----------------------------------------------------------------------------
+void F3DTextureCache::Evict()
+{
+  using namespace std::chrono_literals;
+
+  // Only decoded images are accounted for and can be evicted
+  auto isReady = [](const Entry& entry)
+  { return entry.Image.valid() && entry.Image.wait_for(0s) == std::future_status::ready; };
+
+  std::uintmax_t totalSize = 0;
+  for (const auto& [path, entry] : this->Entries)
+  {
+    if (isReady(entry) && entry.Image.get())
+    {
+      totalSize += static_cast<std::uintmax_t>(entry.Image.get()->GetActualMemorySize()) * 1024;
+    }
+  }
+
+  while (totalSize > this->MaximumSize)
+  {
+    auto oldest = this->Entries.end();
+    for (auto it = this->Entries.begin(); it != this->Entries.end(); ++it)
+    {
+      if (isReady(it->second) && (oldest == this->Entries.end() ||
+                                   it->second.LastUse < oldest->second.LastUse))
+      {
+        oldest = it;
+      }
+    }
+
+    if (oldest == this->Entries.end())
+    {
+      break;
+    }
+
+    if (oldest->second.Image.get())
+    {
+      totalSize -=
+        static_cast<std::uintmax_t>(oldest->second.Image.get()->GetActualMemorySize()) * 1024;
+    }
+    this->Entries.erase(oldest);
+  }
+}
@@ -0,0 +1,97 @@
+/**
+ * @class F3DTextureCache
+ * @brief A process wide cache of decoded texture images
+ *
+ * Images are keyed by their resolved path and invalidated when the file size
+ * or modification time changes, so they can be shared across materials and
+ * across reloads of the same file.
+ * Decoding runs on a small pool of worker threads, callers get a future
+ * and should only wait on it when the image is actually needed.
+ */
+#ifndef F3DTextureCache_h
+#define F3DTextureCache_h
+
+#include <vtkImageData.h>
+#include <vtkImageReader2.h>
+#include <vtkSmartPointer.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class F3DTextureCache
+{
+public:
+  using ImageFuture = std::shared_future<vtkSmartPointer<vtkImageData>>;
+
+  /**
+   * Get the process wide instance
+   */
+  static F3DTextureCache& GetInstance();
+
+  /**
+   * Get the image decoded from the file at path.
+   * If the file is not cached or changed on disk, the provided reader is
+   * used to decode it on a worker thread.
+   * hit is set to true if a cached or pending decoding was reused.
+   */
+  ImageFuture Request(const std::string& path, vtkImageReader2* reader, bool& hit);
+
+  /**
+   * Set the memory budget in bytes of decoded images kept in the cache.
+   * Least recently used images are evicted when it is exceeded.
+   * Default is 1 GiB.
+   */
+  void SetMaximumSize(std::uintmax_t size);
+
+  /**
+   * Remove all the cached images
+   */
+  void Clear();
+
+  ~F3DTextureCache();
+
+private:
+  F3DTextureCache() = default;
+  F3DTextureCache(const F3DTextureCache&) = delete;
+  void operator=(const F3DTextureCache&) = delete;
+
+  struct Entry
+  {
+    std::uintmax_t FileSize = 0;
+    std::int64_t FileTime = 0;
+    std::uint64_t LastUse = 0;
+    ImageFuture Image;
+  };
+
+  /**
+   * Queue a decoding task, starting the workers if needed
+   */
+  void Enqueue(std::function<void()> task);
+
+  /**
+   * Evict least recently used decoded images until the budget is respected
+   * Must be called with Mutex locked
+   */
+  void Evict();
+
+  std::mutex Mutex;
+  std::map<std::string, Entry> Entries;
+  std::uint64_t UseCounter = 0;
+  std::uintmax_t MaximumSize = 1ull << 30;
+
+  std::mutex QueueMutex;
+  std::condition_variable QueueCondition;
+  std::deque<std::function<void()>> Queue;
+  std::vector<std::thread> Workers;
+  bool Stopping = false;
+};
+
+#endif
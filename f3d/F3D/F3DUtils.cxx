@@ -2,9 +2,12 @@
 
 #include <vtkObject.h>
 #include <vtkSetGet.h>
+#include <vtksys/FStream.hxx>
+#include <vtksys/MD5.h>
 
 #include <charconv>
 #include <stdexcept>
+#include <vector>
 
 //----------------------------------------------------------------------------
 double F3DUtils::ParseToDouble(const std::string& str, double def, const std::string& nameError)
@@ -53,3 +56,39 @@ int F3DUtils::ParseToInt(const std::string& str, int def, const std::string& nam
   }
   return value;
 }
+
+//----------------------------------------------------------------------------
+std::string F3DUtils::ComputeFileHash(const std::string& filepath)
+{
+  vtksys::ifstream file;
+  file.open(filepath.c_str(), std::ios_base::binary);
+  if (!file.is_open())
+  {
+    return {};
+  }
+
+  unsigned char digest[16];
+  char md5Hash[33];
+  md5Hash[32] = '\0';
+
+  vtksysMD5* md5 = vtksysMD5_New();
+  vtksysMD5_Initialize(md5);
+
+  std::vector<char> buffer(1 << 20);
+  while (file)
+  {
+    file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    std::streamsize count = file.gcount();
+    if (count > 0)
+    {
+      vtksysMD5_Append(
+        md5, reinterpret_cast<const unsigned char*>(buffer.data()), static_cast<int>(count));
+    }
+  }
+
+  vtksysMD5_Finalize(md5, digest);
+  vtksysMD5_DigestToHex(digest, md5Hash);
+  vtksysMD5_Delete(md5);
+
+  return md5Hash;
+}
@@ -28,6 +28,13 @@ namespace F3DUtils
  * Use nameError in the log for easier debugging.
  */
 /*VTKEXT_EXPORT*/ int ParseToInt(const std::string& str, int def, const std::string& nameError);
+
+/*
+ * Compute the MD5 hash of an existing file on disk and returns it as an hex string.
+ * The file is streamed by chunks so large files are not loaded in memory.
+ * Returns an empty string if the file cannot be read.
+ */
+/*VTKEXT_EXPORT*/ std::string ComputeFileHash(const std::string& filepath);
 };
 
 #endif
@@ -6,6 +6,7 @@
 
 #include <QDebug>
 
+#include "vtkF3DImporter.h"
 #include "vtkF3DRenderer.h"
 
 #include <vtkDoubleArray.h>
@@ -29,12 +30,79 @@ animationManager::animationManager(options& options, window_impl& window)
 {
 }
 
+//----------------------------------------------------------------------------
+animationManager::~animationManager()
+{
+  this->WaitForEvaluation();
+  if (this->EvaluationThread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->EvaluationMutex);
+      this->EvaluationStopping = true;
+    }
+    this->EvaluationCondition.notify_all();
+    this->EvaluationThread.join();
+  }
+}
+
 //----------------------------------------------------------------------------
 void animationManager::SetImporter(vtkImporter* importer)
 {
+  this->WaitForEvaluation();
+  this->EvaluationPending = false;
   this->Importer = importer;
 }
 
+//----------------------------------------------------------------------------
+void animationManager::WaitForEvaluation()
+{
+  std::unique_lock<std::mutex> lock(this->EvaluationMutex);
+  this->EvaluationCondition.wait(lock, [this]() { return !this->EvaluationQueued; });
+}
+
+//----------------------------------------------------------------------------
+void animationManager::StartEvaluation(vtkF3DImporter* importer, double timeValue)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->EvaluationMutex);
+    assert(!this->EvaluationQueued);
+    this->EvaluationImporter = importer;
+    this->PendingTime = timeValue;
+    this->EvaluationQueued = true;
+    this->EvaluationPending = true;
+  }
+  if (!this->EvaluationThread.joinable())
+  {
+    this->EvaluationThread = std::thread([this]() { this->RunEvaluationThread(); });
+  }
+  this->EvaluationCondition.notify_all();
+}
+
+//----------------------------------------------------------------------------
+void animationManager::RunEvaluationThread()
+{
+  std::unique_lock<std::mutex> lock(this->EvaluationMutex);
+  for (;;)
+  {
+    this->EvaluationCondition.wait(
+      lock, [this]() { return this->EvaluationQueued || this->EvaluationStopping; });
+    if (!this->EvaluationQueued)
+    {
+      return;
+    }
+
+    vtkF3DImporter* importer = this->EvaluationImporter;
+    double timeValue = this->PendingTime;
+    lock.unlock();
+    bool result = importer->EvaluateAtTimeValue(timeValue);
+    lock.lock();
+
+    this->EvaluationResult = result;
+    this->EvaluationQueued = false;
+    this->EvaluationCondition.notify_all();
+  }
+}
+
 //----------------------------------------------------------------------------
 void animationManager::SetInteractor(vtkRenderWindowInteractor* interactor)//interactor_impl*
 {
@@ -51,6 +119,9 @@ void animationManager::SetDeltaTime(double deltaTime)
 void animationManager::Initialize()
 {
   assert(this->Importer);
+  // the evaluation done in advance is replaced by this one
+  this->WaitForEvaluation();
+  this->EvaluationPending = false;
   this->Playing = false;
   this->CurrentTime = 0;
   this->CurrentTimeSet = false;
@@ -130,6 +201,7 @@ void animationManager::StopAnimation()
 //----------------------------------------------------------------------------
 void animationManager::ToggleAnimation()
 {
+  this->WaitForEvaluation();
   this->PrepareForAnimationIndices();
   if (!this->PreparedAnimationIndices.value().empty() && this->Interactor)
   {
@@ -143,6 +215,11 @@ void animationManager::ToggleAnimation()
         this->CurrentTime = this->TimeRange[0];
         this->CurrentTimeSet = true;
       }
+
+      // Restart the clock from the current time
+      this->ClockStarted = false;
+      this->DroppedFrames = 0;
+      this->PipelineMisses = 0;
     }
     /*b
     if (this->Playing && this->Options.scene.camera.index.has_value())
@@ -161,31 +238,158 @@ void animationManager::Tick()
 {
   if (this->Playing)
   {
-    this->CurrentTime += this->DeltaTime * this->Options.scene.animation.speed_factor;
-
-    // Modulo computation, compute CurrentTime in the time range.
-    if (this->CurrentTime < this->TimeRange[0] || this->CurrentTime > this->TimeRange[1])
+    if (this->Options.scene.animation.realtime)
     {
-      auto modulo = [](double val, double mod)
+      if (!this->AdvanceRealTime())
       {
-        const double remainder = fmod(val, mod);
-        return remainder < 0 ? remainder + mod : remainder;
-      };
-      this->CurrentTime = this->TimeRange[0] +
-        modulo(this->CurrentTime - this->TimeRange[0], this->TimeRange[1] - this->TimeRange[0]);
+        return;
+      }
     }
+    else
+    {
+      this->CurrentTime += this->DeltaTime * this->Options.scene.animation.speed_factor;
+    }
+    this->CurrentTime = this->WrapTime(this->CurrentTime);
 
-    if (this->LoadAtTime(this->CurrentTime))
+    bool loaded = this->Options.scene.animation.pipelined ? this->LoadPipelined(this->CurrentTime)
+                                                          : this->LoadAtTime(this->CurrentTime);
+    this->ClockTime = this->CurrentTime;
+    if (loaded)
     {
       this->Window.render();
     }
   }
 }
 
+//----------------------------------------------------------------------------
+double animationManager::WrapTime(double timeValue) const
+{
+  // Modulo computation, compute the time in the time range.
+  if (timeValue < this->TimeRange[0] || timeValue > this->TimeRange[1])
+  {
+    auto modulo = [](double val, double mod)
+    {
+      const double remainder = fmod(val, mod);
+      return remainder < 0 ? remainder + mod : remainder;
+    };
+    timeValue = this->TimeRange[0] +
+      modulo(timeValue - this->TimeRange[0], this->TimeRange[1] - this->TimeRange[0]);
+  }
+  return timeValue;
+}
+
+//----------------------------------------------------------------------------
+double animationManager::GetNextFrameTime() const
+{
+  double speed = this->Options.scene.animation.speed_factor;
+  double next = this->Options.scene.animation.realtime
+    ? this->ClockOriginTime + (this->ClockFrame + 1) * this->DeltaTime * speed
+    : this->CurrentTime + this->DeltaTime * speed;
+  return this->WrapTime(next);
+}
+
+//----------------------------------------------------------------------------
+bool animationManager::LoadPipelined(double timeValue)
+{
+  vtkF3DImporter* importer = vtkF3DImporter::SafeDownCast(this->Importer);
+  if (!importer || this->AvailAnimations == 0)
+  {
+    return this->LoadAtTime(timeValue);
+  }
+
+  // Use the frame evaluated while the previous one was rendered if it is the expected one.
+  // Times are compared with a fraction of the frame step, as the clock and the wrapping
+  // may not compute exactly the same value
+  bool evaluated = false;
+  this->WaitForEvaluation();
+  if (this->EvaluationPending)
+  {
+    double tolerance =
+      0.25 * std::abs(this->DeltaTime * this->Options.scene.animation.speed_factor);
+    evaluated = this->EvaluationResult && this->EvaluationImporter == importer &&
+      std::abs(this->PendingTime - timeValue) <= tolerance;
+    this->EvaluationPending = false;
+    if (!evaluated)
+    {
+      this->PipelineMisses++;
+    }
+  }
+
+  if ((!evaluated && !importer->EvaluateAtTimeValue(timeValue)) ||
+    !importer->CommitEvaluatedTimeValue())
+  {
+    qDebug() << "Could not load time value: " << timeValue;
+    return false;
+  }
+  this->CurrentTime = timeValue;
+  this->CurrentTimeSet = true;
+
+  // Evaluate the next frame on a worker thread while this one is rendered
+  this->StartEvaluation(importer, this->GetNextFrameTime());
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool animationManager::AdvanceRealTime()
+{
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  double speed = this->Options.scene.animation.speed_factor;
+
+  // A seek or a speed change restarts the clock, so the animation does not jump
+  if (!this->ClockStarted || this->ClockTime != this->CurrentTime || this->ClockSpeed != speed)
+  {
+    this->ClockStarted = true;
+    this->ClockOrigin = now;
+    this->ClockOriginTime = this->CurrentTime;
+    this->ClockSpeed = speed;
+    this->ClockFrame = 0;
+    this->ClockTime = this->CurrentTime;
+    return false;
+  }
+
+  if (this->DeltaTime <= 0)
+  {
+    return false;
+  }
+
+  // Frames are on a fixed grid from the origin, ticks between two frames are ignored
+  double elapsed = std::chrono::duration<double>(now - this->ClockOrigin).count();
+  long long frame = static_cast<long long>(std::floor(elapsed / this->DeltaTime));
+  if (frame <= this->ClockFrame)
+  {
+    return false;
+  }
+
+  this->DroppedFrames += static_cast<unsigned int>(frame - this->ClockFrame - 1);
+  this->ClockFrame = frame;
+  this->CurrentTime = this->ClockOriginTime + frame * this->DeltaTime * speed;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool animationManager::SeekAtTime(double timeValue)
+{
+  vtkF3DImporter* importer = vtkF3DImporter::SafeDownCast(this->Importer);
+  if (!importer)
+  {
+    return this->LoadAtTime(timeValue);
+  }
+
+  // the pending evaluation of the next frame must not see the flag
+  this->WaitForEvaluation();
+  importer->SetSeeking(true);
+  bool loaded = this->LoadAtTime(timeValue);
+  importer->SetSeeking(false);
+  return loaded;
+}
+
 //----------------------------------------------------------------------------
 bool animationManager::LoadAtTime(double timeValue)
 {
   assert(this->Importer);
+  // the evaluation done in advance is replaced by this one
+  this->WaitForEvaluation();
+  this->EvaluationPending = false;
 
   if (this->AvailAnimations == 0)
   {
@@ -355,6 +559,9 @@ std::string animationManager::GetAnimationName()
 void animationManager::PrepareForAnimationIndices()
 {
   assert(this->Importer);
+  // the evaluation done in advance is replaced by this one
+  this->WaitForEvaluation();
+  this->EvaluationPending = false;
 
   std::vector<int> animIndices = this->Options.scene.animation.indices;
 
@@ -11,9 +11,13 @@
 #include <vtkSmartPointer.h>
 
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <optional>
 #include <set>
+#include <thread>
 
+class vtkF3DImporter;
 class vtkF3DRenderer;
 class vtkImporter;
 class vtkRenderWindow;
@@ -32,7 +36,7 @@ class animationManager
 {
 public:
   animationManager(options& options, window_impl& window);
-  ~animationManager() = default;
+  ~animationManager();
 
   /**
    * Set the interactor to use in the animation_manager, should be set before initializing if any
@@ -87,16 +91,58 @@ public:
   void SetDeltaTime(double deltaTime);
 
   /**
-   * Advance animationTime of DeltaTime and call loadAtTime accordingly
+   * Get the animation delta time in seconds
+   */
+  double GetDeltaTime() const
+  {
+    return DeltaTime;
+  }
+
+  /**
+   * Advance the animation time and call LoadAtTime accordingly.
+   * With scene.animation.realtime, the time follows a monotonic clock: ticks happening
+   * before the next frame, every DeltaTime seconds, do nothing, and frames whose time
+   * already passed are skipped without being evaluated.
+   * Otherwise the time is advanced of DeltaTime at each tick, which is deterministic.
    * Do nothing if IsPlaying is false
    */
   void Tick();
 
+  /**
+   * Get the number of frames skipped by the real-time playback since it was started
+   */
+  unsigned int GetNumberOfDroppedFrames() const
+  {
+    return DroppedFrames;
+  }
+
+  /**
+   * Get the number of frames evaluated in advance by the pipelined playback that could
+   * not be used, because the frame to display was not the expected one, since it was started
+   */
+  unsigned int GetNumberOfPipelineMisses() const
+  {
+    return PipelineMisses;
+  }
+
+  /**
+   * Wait for the evaluation of the next frame running on a worker thread with
+   * scene.animation.pipelined, if any.
+   * Must be called before modifying or removing the importer outside of this class.
+   */
+  void WaitForEvaluation();
+
   /**
    * Load animation at provided time value
    */
   bool LoadAtTime(double timeValue);
 
+  /**
+   * Load animation at provided time value reached by a seek, like moving the time slider,
+   * letting the importer reuse the states of the times already visited
+   */
+  bool SeekAtTime(double timeValue);
+
   /**
    * Return a pair containing the current time range values
    */
@@ -117,6 +163,40 @@ public:
    */
   void PrepareForAnimationIndices();
 
+  /**
+   * Compute the current time of the real-time playback.
+   * Return false if no new frame is due since the last call.
+   */
+  bool AdvanceRealTime();
+
+  /**
+   * Bring a time value back in the time range, looping the animation
+   */
+  double WrapTime(double timeValue) const;
+
+  /**
+   * Get the time of the frame following the current one during playback
+   */
+  double GetNextFrameTime() const;
+
+  /**
+   * Commit the frame at the provided time value, using the evaluation done on the worker
+   * thread if it is the expected one, then start evaluating the next frame on the worker thread.
+   * Falls back on LoadAtTime if the importer cannot split its update.
+   */
+  bool LoadPipelined(double timeValue);
+
+  /**
+   * Queue the evaluation of a time value in the single job slot of the evaluation thread,
+   * starting the thread on first use. The previous job must be finished.
+   */
+  void StartEvaluation(vtkF3DImporter* importer, double timeValue);
+
+  /**
+   * Loop of the evaluation thread, running the queued jobs until the manager is destroyed
+   */
+  void RunEvaluationThread();
+
   options& Options;
   window_impl& Window;
   vtkImporter* Importer = nullptr;
@@ -132,6 +212,28 @@ public:
   double DeltaTime = 0;
   bool CurrentTimeSet = false;
 
+  // real-time playback, frames are counted from the clock origin
+  bool ClockStarted = false;
+  std::chrono::steady_clock::time_point ClockOrigin;
+  double ClockOriginTime = 0;
+  double ClockSpeed = 0;
+  long long ClockFrame = 0;
+  double ClockTime = 0; // last time loaded by Tick, any other value means a seek happened
+  unsigned int DroppedFrames = 0;
+
+  // pipelined playback, the next frame is evaluated while the current one is rendered,
+  // by a persistent thread with a single job slot protected by EvaluationMutex
+  std::thread EvaluationThread;
+  std::mutex EvaluationMutex;
+  std::condition_variable EvaluationCondition;
+  vtkF3DImporter* EvaluationImporter = nullptr;
+  double PendingTime = 0;
+  bool EvaluationQueued = false;  // the job is queued or running
+  bool EvaluationPending = false; // the result of the job is not used yet
+  bool EvaluationResult = false;
+  bool EvaluationStopping = false;
+  unsigned int PipelineMisses = 0;
+
   // b vtkSmartPointer<vtkProgressBarWidget> ProgressWidget;
 };
 }
@@ -269,6 +269,7 @@ public:
       bool skybox = false;
     } background;
 
+    bool culling = false;
     struct effect {
       bool ambient_occlusion = false;
       [[deprecated("use render.effect.antialiasing.enable instead")]] bool anti_aliasing = false;
@@ -300,6 +301,11 @@ public:
     } light;
 
     std::optional<double> line_width;
+    struct lod {
+      bool full_detail = false;
+      std::vector<double> thresholds = {400.0, 200.0, 100.0, 50.0};
+    } lod;
+
     std::optional<double> point_size;
     struct raytracing {
       bool denoise = false;
@@ -315,9 +321,28 @@ public:
       bool autoplay = false;
       [[deprecated("use scene.animation.indices instead")]] int index = 0;
       std::vector<int> indices = {0};
+      bool pipelined = false;
+      int pose_cache = 64;
+      bool realtime = false;
       f3d::ratio_t speed_factor = f3d::ratio_t{1.0};
     } animation;
 
+    struct assimp {
+      bool adopt_buffers = false;
+      bool bake_animation = false;
+      int bake_budget = 256;
+      bool batch_static = false;
+      bool cache = false;
+      int cache_budget = 1024;
+      bool find_instances = false;
+      bool improve_cache_locality = false;
+      bool join_identical_vertices = false;
+      int lod_levels = 0;
+      bool optimize_meshes = false;
+      bool remove_redundant_materials = false;
+      int threads = 0;
+    } assimp;
+
     struct camera {
       std::optional<int> index;
       std::optional<bool> orthographic;
@@ -57,6 +57,7 @@ void set(options& opt, std::string_view name, const option_variant_t& value)
     else if (name == "render.background.blur.enable") opt.render.background.blur.enable = {std::get<bool>(value)};
     else if (name == "render.background.color") opt.render.background.color = f3d::color_t{std::get<std::vector<double>>(value)};
     else if (name == "render.background.skybox") opt.render.background.skybox = {std::get<bool>(value)};
+    else if (name == "render.culling") opt.render.culling = {std::get<bool>(value)};
     else if (name == "render.effect.ambient_occlusion") opt.render.effect.ambient_occlusion = {std::get<bool>(value)};
     else if (name == "render.effect.anti_aliasing") opt.render.effect.anti_aliasing = {std::get<bool>(value)};
     else if (name == "render.effect.antialiasing.enable") opt.render.effect.antialiasing.enable = {std::get<bool>(value)};
@@ -73,6 +74,8 @@ void set(options& opt, std::string_view name, const option_variant_t& value)
     else if (name == "render.hdri.file") opt.render.hdri.file = {std::get<std::string>(value)};
     else if (name == "render.light.intensity") opt.render.light.intensity = {std::get<double>(value)};
     else if (name == "render.line_width") opt.render.line_width = {std::get<double>(value)};
+    else if (name == "render.lod.full_detail") opt.render.lod.full_detail = {std::get<bool>(value)};
+    else if (name == "render.lod.thresholds") opt.render.lod.thresholds = {std::get<std::vector<double>>(value)};
     else if (name == "render.point_size") opt.render.point_size = {std::get<double>(value)};
     else if (name == "render.raytracing.denoise") opt.render.raytracing.denoise = {std::get<bool>(value)};
     else if (name == "render.raytracing.enable") opt.render.raytracing.enable = {std::get<bool>(value)};
@@ -81,7 +84,23 @@ void set(options& opt, std::string_view name, const option_variant_t& value)
     else if (name == "scene.animation.autoplay") opt.scene.animation.autoplay = {std::get<bool>(value)};
     else if (name == "scene.animation.index") opt.scene.animation.index = {std::get<int>(value)};
     else if (name == "scene.animation.indices") opt.scene.animation.indices = {std::get<std::vector<int>>(value)};
+    else if (name == "scene.animation.pipelined") opt.scene.animation.pipelined = {std::get<bool>(value)};
+    else if (name == "scene.animation.pose_cache") opt.scene.animation.pose_cache = {std::get<int>(value)};
+    else if (name == "scene.animation.realtime") opt.scene.animation.realtime = {std::get<bool>(value)};
     else if (name == "scene.animation.speed_factor") opt.scene.animation.speed_factor = f3d::ratio_t{std::get<double>(value)};
+    else if (name == "scene.assimp.adopt_buffers") opt.scene.assimp.adopt_buffers = {std::get<bool>(value)};
+    else if (name == "scene.assimp.bake_animation") opt.scene.assimp.bake_animation = {std::get<bool>(value)};
+    else if (name == "scene.assimp.bake_budget") opt.scene.assimp.bake_budget = {std::get<int>(value)};
+    else if (name == "scene.assimp.batch_static") opt.scene.assimp.batch_static = {std::get<bool>(value)};
+    else if (name == "scene.assimp.cache") opt.scene.assimp.cache = {std::get<bool>(value)};
+    else if (name == "scene.assimp.cache_budget") opt.scene.assimp.cache_budget = {std::get<int>(value)};
+    else if (name == "scene.assimp.find_instances") opt.scene.assimp.find_instances = {std::get<bool>(value)};
+    else if (name == "scene.assimp.improve_cache_locality") opt.scene.assimp.improve_cache_locality = {std::get<bool>(value)};
+    else if (name == "scene.assimp.join_identical_vertices") opt.scene.assimp.join_identical_vertices = {std::get<bool>(value)};
+    else if (name == "scene.assimp.lod_levels") opt.scene.assimp.lod_levels = {std::get<int>(value)};
+    else if (name == "scene.assimp.optimize_meshes") opt.scene.assimp.optimize_meshes = {std::get<bool>(value)};
+    else if (name == "scene.assimp.remove_redundant_materials") opt.scene.assimp.remove_redundant_materials = {std::get<bool>(value)};
+    else if (name == "scene.assimp.threads") opt.scene.assimp.threads = {std::get<int>(value)};
     else if (name == "scene.camera.index") opt.scene.camera.index = {std::get<int>(value)};
     else if (name == "scene.camera.orthographic") opt.scene.camera.orthographic = {std::get<bool>(value)};
     else if (name == "scene.force_reader") opt.scene.force_reader = {std::get<std::string>(value)};
@@ -159,6 +178,7 @@ option_variant_t get(const options& opt, std::string_view name)
     else if (name == "render.background.blur.enable") return opt.render.background.blur.enable;
     else if (name == "render.background.color") return opt.render.background.color;
     else if (name == "render.background.skybox") return opt.render.background.skybox;
+    else if (name == "render.culling") return opt.render.culling;
     else if (name == "render.effect.ambient_occlusion") return opt.render.effect.ambient_occlusion;
     else if (name == "render.effect.anti_aliasing") return opt.render.effect.anti_aliasing;
     else if (name == "render.effect.antialiasing.enable") return opt.render.effect.antialiasing.enable;
@@ -175,6 +195,8 @@ option_variant_t get(const options& opt, std::string_view name)
     else if (name == "render.hdri.file") return opt.render.hdri.file.value().string();
     else if (name == "render.light.intensity") return opt.render.light.intensity;
     else if (name == "render.line_width") return opt.render.line_width.value();
+    else if (name == "render.lod.full_detail") return opt.render.lod.full_detail;
+    else if (name == "render.lod.thresholds") return opt.render.lod.thresholds;
     else if (name == "render.point_size") return opt.render.point_size.value();
     else if (name == "render.raytracing.denoise") return opt.render.raytracing.denoise;
     else if (name == "render.raytracing.enable") return opt.render.raytracing.enable;
@@ -183,7 +205,23 @@ option_variant_t get(const options& opt, std::string_view name)
     else if (name == "scene.animation.autoplay") return opt.scene.animation.autoplay;
     else if (name == "scene.animation.index") return opt.scene.animation.index;
     else if (name == "scene.animation.indices") return opt.scene.animation.indices;
+    else if (name == "scene.animation.pipelined") return opt.scene.animation.pipelined;
+    else if (name == "scene.animation.pose_cache") return opt.scene.animation.pose_cache;
+    else if (name == "scene.animation.realtime") return opt.scene.animation.realtime;
     else if (name == "scene.animation.speed_factor") return opt.scene.animation.speed_factor;
+    else if (name == "scene.assimp.adopt_buffers") return opt.scene.assimp.adopt_buffers;
+    else if (name == "scene.assimp.bake_animation") return opt.scene.assimp.bake_animation;
+    else if (name == "scene.assimp.bake_budget") return opt.scene.assimp.bake_budget;
+    else if (name == "scene.assimp.batch_static") return opt.scene.assimp.batch_static;
+    else if (name == "scene.assimp.cache") return opt.scene.assimp.cache;
+    else if (name == "scene.assimp.cache_budget") return opt.scene.assimp.cache_budget;
+    else if (name == "scene.assimp.find_instances") return opt.scene.assimp.find_instances;
+    else if (name == "scene.assimp.improve_cache_locality") return opt.scene.assimp.improve_cache_locality;
+    else if (name == "scene.assimp.join_identical_vertices") return opt.scene.assimp.join_identical_vertices;
+    else if (name == "scene.assimp.lod_levels") return opt.scene.assimp.lod_levels;
+    else if (name == "scene.assimp.optimize_meshes") return opt.scene.assimp.optimize_meshes;
+    else if (name == "scene.assimp.remove_redundant_materials") return opt.scene.assimp.remove_redundant_materials;
+    else if (name == "scene.assimp.threads") return opt.scene.assimp.threads;
     else if (name == "scene.camera.index") return opt.scene.camera.index.value();
     else if (name == "scene.camera.orthographic") return opt.scene.camera.orthographic.value();
     else if (name == "scene.force_reader") return opt.scene.force_reader.value();
@@ -253,6 +291,7 @@ std::vector<std::string> getNames()
   "render.background.blur.enable",
   "render.background.color",
   "render.background.skybox",
+  "render.culling",
   "render.effect.ambient_occlusion",
   "render.effect.anti_aliasing",
   "render.effect.antialiasing.enable",
@@ -269,6 +308,8 @@ std::vector<std::string> getNames()
   "render.hdri.file",
   "render.light.intensity",
   "render.line_width",
+  "render.lod.full_detail",
+  "render.lod.thresholds",
   "render.point_size",
   "render.raytracing.denoise",
   "render.raytracing.enable",
@@ -277,7 +318,23 @@ std::vector<std::string> getNames()
   "scene.animation.autoplay",
   "scene.animation.index",
   "scene.animation.indices",
+  "scene.animation.pipelined",
+  "scene.animation.pose_cache",
+  "scene.animation.realtime",
   "scene.animation.speed_factor",
+  "scene.assimp.adopt_buffers",
+  "scene.assimp.bake_animation",
+  "scene.assimp.bake_budget",
+  "scene.assimp.batch_static",
+  "scene.assimp.cache",
+  "scene.assimp.cache_budget",
+  "scene.assimp.find_instances",
+  "scene.assimp.improve_cache_locality",
+  "scene.assimp.join_identical_vertices",
+  "scene.assimp.lod_levels",
+  "scene.assimp.optimize_meshes",
+  "scene.assimp.remove_redundant_materials",
+  "scene.assimp.threads",
   "scene.camera.index",
   "scene.camera.orthographic",
   "scene.force_reader",
@@ -341,6 +398,7 @@ void setAsString(options& opt, std::string_view name, const std::string& str)
   else if (name == "render.background.blur.enable") opt.render.background.blur.enable = options_tools::parse<bool>(str);
   else if (name == "render.background.color") opt.render.background.color = options_tools::parse<f3d::color_t>(str);
   else if (name == "render.background.skybox") opt.render.background.skybox = options_tools::parse<bool>(str);
+  else if (name == "render.culling") opt.render.culling = options_tools::parse<bool>(str);
   else if (name == "render.effect.ambient_occlusion") opt.render.effect.ambient_occlusion = options_tools::parse<bool>(str);
   else if (name == "render.effect.anti_aliasing") opt.render.effect.anti_aliasing = options_tools::parse<bool>(str);
   else if (name == "render.effect.antialiasing.enable") opt.render.effect.antialiasing.enable = options_tools::parse<bool>(str);
@@ -357,6 +415,8 @@ void setAsString(options& opt, std::string_view name, const std::string& str)
   else if (name == "render.hdri.file") opt.render.hdri.file = options_tools::parse<std::filesystem::path>(str);
   else if (name == "render.light.intensity") opt.render.light.intensity = options_tools::parse<double>(str);
   else if (name == "render.line_width") opt.render.line_width = options_tools::parse<double>(str);
+  else if (name == "render.lod.full_detail") opt.render.lod.full_detail = options_tools::parse<bool>(str);
+  else if (name == "render.lod.thresholds") opt.render.lod.thresholds = options_tools::parse<std::vector<double>>(str);
   else if (name == "render.point_size") opt.render.point_size = options_tools::parse<double>(str);
   else if (name == "render.raytracing.denoise") opt.render.raytracing.denoise = options_tools::parse<bool>(str);
   else if (name == "render.raytracing.enable") opt.render.raytracing.enable = options_tools::parse<bool>(str);
@@ -365,7 +425,23 @@ void setAsString(options& opt, std::string_view name, const std::string& str)
   else if (name == "scene.animation.autoplay") opt.scene.animation.autoplay = options_tools::parse<bool>(str);
   else if (name == "scene.animation.index") opt.scene.animation.index = options_tools::parse<int>(str);
   else if (name == "scene.animation.indices") opt.scene.animation.indices = options_tools::parse<std::vector<int>>(str);
+  else if (name == "scene.animation.pipelined") opt.scene.animation.pipelined = options_tools::parse<bool>(str);
+  else if (name == "scene.animation.pose_cache") opt.scene.animation.pose_cache = options_tools::parse<int>(str);
+  else if (name == "scene.animation.realtime") opt.scene.animation.realtime = options_tools::parse<bool>(str);
   else if (name == "scene.animation.speed_factor") opt.scene.animation.speed_factor = options_tools::parse<f3d::ratio_t>(str);
+  else if (name == "scene.assimp.adopt_buffers") opt.scene.assimp.adopt_buffers = options_tools::parse<bool>(str);
+  else if (name == "scene.assimp.bake_animation") opt.scene.assimp.bake_animation = options_tools::parse<bool>(str);
+  else if (name == "scene.assimp.bake_budget") opt.scene.assimp.bake_budget = options_tools::parse<int>(str);
+  else if (name == "scene.assimp.batch_static") opt.scene.assimp.batch_static = options_tools::parse<bool>(str);
+  else if (name == "scene.assimp.cache") opt.scene.assimp.cache = options_tools::parse<bool>(str);
+  else if (name == "scene.assimp.cache_budget") opt.scene.assimp.cache_budget = options_tools::parse<int>(str);
+  else if (name == "scene.assimp.find_instances") opt.scene.assimp.find_instances = options_tools::parse<bool>(str);
+  else if (name == "scene.assimp.improve_cache_locality") opt.scene.assimp.improve_cache_locality = options_tools::parse<bool>(str);
+  else if (name == "scene.assimp.join_identical_vertices") opt.scene.assimp.join_identical_vertices = options_tools::parse<bool>(str);
+  else if (name == "scene.assimp.lod_levels") opt.scene.assimp.lod_levels = options_tools::parse<int>(str);
+  else if (name == "scene.assimp.optimize_meshes") opt.scene.assimp.optimize_meshes = options_tools::parse<bool>(str);
+  else if (name == "scene.assimp.remove_redundant_materials") opt.scene.assimp.remove_redundant_materials = options_tools::parse<bool>(str);
+  else if (name == "scene.assimp.threads") opt.scene.assimp.threads = options_tools::parse<int>(str);
   else if (name == "scene.camera.index") opt.scene.camera.index = options_tools::parse<int>(str);
   else if (name == "scene.camera.orthographic") opt.scene.camera.orthographic = options_tools::parse<bool>(str);
   else if (name == "scene.force_reader") opt.scene.force_reader = options_tools::parse<std::string>(str);
@@ -431,6 +507,7 @@ std::string getAsString(const options& opt, std::string_view name)
     else if (name == "render.background.blur.enable") return options_tools::format(opt.render.background.blur.enable);
     else if (name == "render.background.color") return options_tools::format(opt.render.background.color);
     else if (name == "render.background.skybox") return options_tools::format(opt.render.background.skybox);
+    else if (name == "render.culling") return options_tools::format(opt.render.culling);
     else if (name == "render.effect.ambient_occlusion") return options_tools::format(opt.render.effect.ambient_occlusion);
     else if (name == "render.effect.anti_aliasing") return options_tools::format(opt.render.effect.anti_aliasing);
     else if (name == "render.effect.antialiasing.enable") return options_tools::format(opt.render.effect.antialiasing.enable);
@@ -447,6 +524,8 @@ std::string getAsString(const options& opt, std::string_view name)
     else if (name == "render.hdri.file") return options_tools::format(opt.render.hdri.file.value());
     else if (name == "render.light.intensity") return options_tools::format(opt.render.light.intensity);
     else if (name == "render.line_width") return options_tools::format(opt.render.line_width.value());
+    else if (name == "render.lod.full_detail") return options_tools::format(opt.render.lod.full_detail);
+    else if (name == "render.lod.thresholds") return options_tools::format(opt.render.lod.thresholds);
     else if (name == "render.point_size") return options_tools::format(opt.render.point_size.value());
     else if (name == "render.raytracing.denoise") return options_tools::format(opt.render.raytracing.denoise);
     else if (name == "render.raytracing.enable") return options_tools::format(opt.render.raytracing.enable);
@@ -455,7 +534,23 @@ std::string getAsString(const options& opt, std::string_view name)
     else if (name == "scene.animation.autoplay") return options_tools::format(opt.scene.animation.autoplay);
     else if (name == "scene.animation.index") return options_tools::format(opt.scene.animation.index);
     else if (name == "scene.animation.indices") return options_tools::format(opt.scene.animation.indices);
+    else if (name == "scene.animation.pipelined") return options_tools::format(opt.scene.animation.pipelined);
+    else if (name == "scene.animation.pose_cache") return options_tools::format(opt.scene.animation.pose_cache);
+    else if (name == "scene.animation.realtime") return options_tools::format(opt.scene.animation.realtime);
     else if (name == "scene.animation.speed_factor") return options_tools::format(opt.scene.animation.speed_factor);
+    else if (name == "scene.assimp.adopt_buffers") return options_tools::format(opt.scene.assimp.adopt_buffers);
+    else if (name == "scene.assimp.bake_animation") return options_tools::format(opt.scene.assimp.bake_animation);
+    else if (name == "scene.assimp.bake_budget") return options_tools::format(opt.scene.assimp.bake_budget);
+    else if (name == "scene.assimp.batch_static") return options_tools::format(opt.scene.assimp.batch_static);
+    else if (name == "scene.assimp.cache") return options_tools::format(opt.scene.assimp.cache);
+    else if (name == "scene.assimp.cache_budget") return options_tools::format(opt.scene.assimp.cache_budget);
+    else if (name == "scene.assimp.find_instances") return options_tools::format(opt.scene.assimp.find_instances);
+    else if (name == "scene.assimp.improve_cache_locality") return options_tools::format(opt.scene.assimp.improve_cache_locality);
+    else if (name == "scene.assimp.join_identical_vertices") return options_tools::format(opt.scene.assimp.join_identical_vertices);
+    else if (name == "scene.assimp.lod_levels") return options_tools::format(opt.scene.assimp.lod_levels);
+    else if (name == "scene.assimp.optimize_meshes") return options_tools::format(opt.scene.assimp.optimize_meshes);
+    else if (name == "scene.assimp.remove_redundant_materials") return options_tools::format(opt.scene.assimp.remove_redundant_materials);
+    else if (name == "scene.assimp.threads") return options_tools::format(opt.scene.assimp.threads);
     else if (name == "scene.camera.index") return options_tools::format(opt.scene.camera.index.value());
     else if (name == "scene.camera.orthographic") return options_tools::format(opt.scene.camera.orthographic.value());
     else if (name == "scene.force_reader") return options_tools::format(opt.scene.force_reader.value());
@@ -525,6 +620,7 @@ bool isOptional(std::string_view name)
   else if (name == "render.background.blur.enable") return false;
   else if (name == "render.background.color") return false;
   else if (name == "render.background.skybox") return false;
+  else if (name == "render.culling") return false;
   else if (name == "render.effect.ambient_occlusion") return false;
   else if (name == "render.effect.anti_aliasing") return false;
   else if (name == "render.effect.antialiasing.enable") return false;
@@ -541,6 +637,8 @@ bool isOptional(std::string_view name)
   else if (name == "render.hdri.file") return true;
   else if (name == "render.light.intensity") return false;
   else if (name == "render.line_width") return true;
+  else if (name == "render.lod.full_detail") return false;
+  else if (name == "render.lod.thresholds") return false;
   else if (name == "render.point_size") return true;
   else if (name == "render.raytracing.denoise") return false;
   else if (name == "render.raytracing.enable") return false;
@@ -549,7 +647,23 @@ bool isOptional(std::string_view name)
   else if (name == "scene.animation.autoplay") return false;
   else if (name == "scene.animation.index") return false;
   else if (name == "scene.animation.indices") return false;
+  else if (name == "scene.animation.pipelined") return false;
+  else if (name == "scene.animation.pose_cache") return false;
+  else if (name == "scene.animation.realtime") return false;
   else if (name == "scene.animation.speed_factor") return false;
+  else if (name == "scene.assimp.adopt_buffers") return false;
+  else if (name == "scene.assimp.bake_animation") return false;
+  else if (name == "scene.assimp.bake_budget") return false;
+  else if (name == "scene.assimp.batch_static") return false;
+  else if (name == "scene.assimp.cache") return false;
+  else if (name == "scene.assimp.cache_budget") return false;
+  else if (name == "scene.assimp.find_instances") return false;
+  else if (name == "scene.assimp.improve_cache_locality") return false;
+  else if (name == "scene.assimp.join_identical_vertices") return false;
+  else if (name == "scene.assimp.lod_levels") return false;
+  else if (name == "scene.assimp.optimize_meshes") return false;
+  else if (name == "scene.assimp.remove_redundant_materials") return false;
+  else if (name == "scene.assimp.threads") return false;
   else if (name == "scene.camera.index") return true;
   else if (name == "scene.camera.orthographic") return true;
   else if (name == "scene.force_reader") return true;
@@ -614,6 +728,7 @@ void reset(options& opt, std::string_view name)
   else if (name == "render.background.blur.enable") opt.render.background.blur.enable = false;
   else if (name == "render.background.color") opt.render.background.color = f3d::color_t{0.2, 0.2, 0.2};
   else if (name == "render.background.skybox") opt.render.background.skybox = false;
+  else if (name == "render.culling") opt.render.culling = false;
   else if (name == "render.effect.ambient_occlusion") opt.render.effect.ambient_occlusion = false;
   else if (name == "render.effect.anti_aliasing") opt.render.effect.anti_aliasing = false;
   else if (name == "render.effect.antialiasing.enable") opt.render.effect.antialiasing.enable = false;
@@ -630,6 +745,8 @@ void reset(options& opt, std::string_view name)
   else if (name == "render.hdri.file") opt.render.hdri.file.reset();
   else if (name == "render.light.intensity") opt.render.light.intensity = 1.0;
   else if (name == "render.line_width") opt.render.line_width.reset();
+  else if (name == "render.lod.full_detail") opt.render.lod.full_detail = false;
+  else if (name == "render.lod.thresholds") opt.render.lod.thresholds = {400.0, 200.0, 100.0, 50.0};
   else if (name == "render.point_size") opt.render.point_size.reset();
   else if (name == "render.raytracing.denoise") opt.render.raytracing.denoise = false;
   else if (name == "render.raytracing.enable") opt.render.raytracing.enable = false;
@@ -638,7 +755,23 @@ void reset(options& opt, std::string_view name)
   else if (name == "scene.animation.autoplay") opt.scene.animation.autoplay = false;
   else if (name == "scene.animation.index") opt.scene.animation.index = 0;
   else if (name == "scene.animation.indices") opt.scene.animation.indices = {0};
+  else if (name == "scene.animation.pipelined") opt.scene.animation.pipelined = false;
+  else if (name == "scene.animation.pose_cache") opt.scene.animation.pose_cache = 64;
+  else if (name == "scene.animation.realtime") opt.scene.animation.realtime = false;
   else if (name == "scene.animation.speed_factor") opt.scene.animation.speed_factor = f3d::ratio_t{1.0};
+  else if (name == "scene.assimp.adopt_buffers") opt.scene.assimp.adopt_buffers = false;
+  else if (name == "scene.assimp.bake_animation") opt.scene.assimp.bake_animation = false;
+  else if (name == "scene.assimp.bake_budget") opt.scene.assimp.bake_budget = 256;
+  else if (name == "scene.assimp.batch_static") opt.scene.assimp.batch_static = false;
+  else if (name == "scene.assimp.cache") opt.scene.assimp.cache = false;
+  else if (name == "scene.assimp.cache_budget") opt.scene.assimp.cache_budget = 1024;
+  else if (name == "scene.assimp.find_instances") opt.scene.assimp.find_instances = false;
+  else if (name == "scene.assimp.improve_cache_locality") opt.scene.assimp.improve_cache_locality = false;
+  else if (name == "scene.assimp.join_identical_vertices") opt.scene.assimp.join_identical_vertices = false;
+  else if (name == "scene.assimp.lod_levels") opt.scene.assimp.lod_levels = 0;
+  else if (name == "scene.assimp.optimize_meshes") opt.scene.assimp.optimize_meshes = false;
+  else if (name == "scene.assimp.remove_redundant_materials") opt.scene.assimp.remove_redundant_materials = false;
+  else if (name == "scene.assimp.threads") opt.scene.assimp.threads = 0;
   else if (name == "scene.camera.index") opt.scene.camera.index.reset();
   else if (name == "scene.camera.orthographic") opt.scene.camera.orthographic.reset();
   else if (name == "scene.force_reader") opt.scene.force_reader.reset();
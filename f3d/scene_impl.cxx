@@ -43,6 +43,41 @@ scene& scene_impl::add(const std::vector<fs::path>& filePaths)
     return *this;
   }
 
+  std::vector<vtkSmartPointer<vtkImporter>> importers = this->CreateImporters(filePaths);
+
+  qDebug() << "\nLoading files: ";
+  if (filePaths.size() == 1)
+  {
+    qDebug() << filePaths[0].string();
+  }
+  else
+  {
+    for (const fs::path& filePathStr : filePaths)
+    {
+      qDebug() << "- " << filePathStr.string();
+    }
+  }
+
+  return this->add(importers);
+}
+
+//----------------------------------------------------------------------------
+scene_impl::ImporterConfiguration scene_impl::GetImporterConfiguration() const
+{
+  return this->Internals->GetImporterConfiguration();
+}
+
+//----------------------------------------------------------------------------
+std::vector<vtkSmartPointer<vtkImporter>> scene_impl::CreateImporters(
+  const std::vector<fs::path>& filePaths)
+{
+  return scene_impl::CreateImporters(filePaths, this->GetImporterConfiguration());
+}
+
+//----------------------------------------------------------------------------
+std::vector<vtkSmartPointer<vtkImporter>> scene_impl::CreateImporters(
+  const std::vector<fs::path>& filePaths, const ImporterConfiguration& config)
+{
   std::vector<vtkSmartPointer<vtkImporter>> importers;
   for (const fs::path& filePath : filePaths)
   {
@@ -55,7 +90,7 @@ scene& scene_impl::add(const std::vector<fs::path>& filePaths)
     {
       throw scene::load_failure_exception(filePath.string() + " does not exists");
     }
-    std::optional<std::string> forceReader = this->Internals->Options.scene.force_reader;
+    std::optional<std::string> forceReader = config.Options.scene.force_reader;
     // Recover the importer for the provided file path
     f3d::reader* reader = f3d::factory::instance()->getReader(filePath.string(), forceReader);
     if (reader)
@@ -90,22 +125,15 @@ scene& scene_impl::add(const std::vector<fs::path>& filePaths)
       genericImporter->SetInternalReader(vtkReader);
       importer = genericImporter;
     }
+    scene_impl::internals::ConfigureImporter(importer, config);
     importers.emplace_back(importer);
   }
+  return importers;
+}
 
-  qDebug() << "\nLoading files: ";
-  if (filePaths.size() == 1)
-  {
-    qDebug() << filePaths[0].string();
-  }
-  else
-  {
-    for (const fs::path& filePathStr : filePaths)
-    {
-      qDebug() << "- " << filePathStr.string();
-    }
-  }
-
+//----------------------------------------------------------------------------
+scene& scene_impl::add(const std::vector<vtkSmartPointer<vtkImporter>>& importers)
+{
   this->Internals->Load(importers);
   return *this;
 }
@@ -139,7 +167,8 @@ scene& scene_impl::add(const mesh_t& mesh)
 //----------------------------------------------------------------------------
 scene& scene_impl::clear()
 {
-  // Clear the meta importer from all importers
+  // Clear the meta importer from all importers, once they are not evaluated anymore
+  this->Internals->AnimationManager.WaitForEvaluation();
   this->Internals->MetaImporter->Clear();
 
   // Clear the window of all actors
@@ -158,7 +187,7 @@ bool scene_impl::supports(const fs::path& filePath)
 //----------------------------------------------------------------------------
 scene& scene_impl::loadAnimationTime(double timeValue)
 {
-  this->Internals->AnimationManager.LoadAtTime(timeValue);
+  this->Internals->AnimationManager.SeekAtTime(timeValue);
   //b scene_impl::internals::DisplayAllInfo(this->Internals->MetaImporter, this->Internals->Window);
   return *this;
 }
@@ -11,8 +11,11 @@
 
 #include "scene.h"
 
+#include <vtkSmartPointer.h>
+
 #include <memory>
 
+class vtkImporter;
 class vtkRenderWindowInteractor;
 
 namespace f3d
@@ -43,6 +46,43 @@ public:
   unsigned int availableAnimations() const override;
   ///@}
 
+  /**
+   * Implementation only API.
+   * Snapshot of the options, animation and window state used to configure importers.
+   */
+  struct ImporterConfiguration;
+
+  /**
+   * Implementation only API.
+   * Get the current importer configuration, to create importers on another thread.
+   */
+  ImporterConfiguration GetImporterConfiguration() const;
+
+  /**
+   * Implementation only API.
+   * Create and configure the importers for the provided files without reading them.
+   * Throw a scene::load_failure_exception on invalid input.
+   */
+  std::vector<vtkSmartPointer<vtkImporter>> CreateImporters(
+    const std::vector<std::filesystem::path>& filePaths);
+
+  /**
+   * Implementation only API.
+   * Create and configure the importers for the provided files from a configuration.
+   * This does not use the scene and can be called from any thread,
+   * so files can then be read in the background before being added.
+   * Throw a scene::load_failure_exception on invalid input.
+   */
+  static std::vector<vtkSmartPointer<vtkImporter>> CreateImporters(
+    const std::vector<std::filesystem::path>& filePaths, const ImporterConfiguration& config);
+
+  /**
+   * Implementation only API.
+   * Add importers created by CreateImporters to the scene.
+   * Throw a scene::load_failure_exception if they cannot be loaded.
+   */
+  scene& add(const std::vector<vtkSmartPointer<vtkImporter>>& importers);
+
   /**
    * Implementation only API.
    * Set the interactor to use when interacting and set the AnimationManager on the interactor.
@@ -68,10 +108,12 @@ public:
 #include "window_impl.h"
 
 #include "factory.h"
+#include "vtkF3DAssimpImporter.h"
 #include "vtkF3DGenericImporter.h"
 #include "vtkF3DMemoryMesh.h"
 #include "vtkF3DMetaImporter.h"
 
+#include <algorithm>
 #include <optional>
 #include <vtkCallbackCommand.h>
 #include <vtkProgressBarRepresentation.h>
@@ -88,6 +130,13 @@ namespace f3d
 {
 namespace detail
 {
+struct scene_impl::ImporterConfiguration
+{
+    options Options;
+    double DeltaTime = 0;
+    std::filesystem::path CachePath;
+};
+
 class scene_impl::internals
 {
 public:
@@ -149,8 +198,56 @@ public:
         data->timer->StartTimer();
     }
 
+    /**
+     * Get the state ConfigureImporter depends on
+     */
+    ImporterConfiguration GetImporterConfiguration() const
+    {
+        return { this->Options, this->AnimationManager.GetDeltaTime(), this->Window.GetCachePath() };
+    }
+
+    /**
+     * Forward the scene options to the importers supporting them
+     */
+    static void ConfigureImporter(vtkImporter* importer, const ImporterConfiguration& config)
+    {
+        vtkF3DAssimpImporter* assimpImporter = vtkF3DAssimpImporter::SafeDownCast(importer);
+        if (assimpImporter)
+        {
+            const options& opt = config.Options;
+            assimpImporter->SetNumberOfThreads(opt.scene.assimp.threads);
+            assimpImporter->SetAdoptAssimpBuffers(opt.scene.assimp.adopt_buffers);
+            assimpImporter->SetBatchStaticMeshes(opt.scene.assimp.batch_static);
+            assimpImporter->SetNumberOfLODs(opt.scene.assimp.lod_levels);
+            const auto& assimpOptions = opt.scene.assimp;
+            unsigned int steps = 0;
+            steps |= assimpOptions.find_instances ? aiProcess_FindInstances : 0;
+            steps |= assimpOptions.improve_cache_locality ? aiProcess_ImproveCacheLocality : 0;
+            steps |= assimpOptions.join_identical_vertices ? aiProcess_JoinIdenticalVertices : 0;
+            steps |= assimpOptions.optimize_meshes ? aiProcess_OptimizeMeshes : 0;
+            steps |= assimpOptions.remove_redundant_materials ? aiProcess_RemoveRedundantMaterials : 0;
+            assimpImporter->SetPostProcessSteps(steps);
+
+            double deltaTime = config.DeltaTime;
+            assimpImporter->SetAnimationBakingRate(
+                opt.scene.assimp.bake_animation && deltaTime > 0 ? 1.0 / deltaTime : 0.0);
+            assimpImporter->SetAnimationBakingBudget(
+                static_cast<vtkIdType>(opt.scene.assimp.bake_budget) << 20);
+            assimpImporter->SetPoseCacheSize(opt.scene.animation.pose_cache);
+            if (deltaTime > 0)
+            {
+                assimpImporter->SetPoseCacheTimeStep(deltaTime);
+            }
+            assimpImporter->SetCachePath(
+                opt.scene.assimp.cache ? config.CachePath.string() : std::string());
+            assimpImporter->SetCacheBudget(
+                static_cast<vtkIdType>(std::max(opt.scene.assimp.cache_budget, 0)) << 20);
+        }
+    }
+
     void Load(const std::vector<vtkSmartPointer<vtkImporter>>& importers)
     {
+        // importers were configured by CreateImporters
         for (const vtkSmartPointer<vtkImporter>& importer : importers)
         {
             this->MetaImporter->AddImporter(importer);
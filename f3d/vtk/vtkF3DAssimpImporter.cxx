@@ -1,6 +1,8 @@
 #include "vtkF3DAssimpImporter.h"
 
 vtkStandardNewMacro(vtkF3DAssimpImporter);
+vtkStandardNewMacro(vtkF3DAssimpBufferOwner);
+vtkInformationKeyMacro(vtkF3DAssimpImporter, ASSIMP_BUFFER_OWNER, ObjectBase);
 
 
 //----------------------------------------------------------------------------
@@ -18,21 +20,38 @@ int vtkF3DAssimpImporter::ImportBegin()
   return this->Internals->ReadScene(this->FileName);
 }
 
+//----------------------------------------------------------------------------
+bool vtkF3DAssimpImporter::Preload()
+{
+  return this->Internals->ReadScene(this->FileName);
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DAssimpImporter::AbortImport()
+{
+  this->Internals->AbortRequested = true;
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DAssimpImporter::ImportActors(vtkRenderer* renderer)
 {
   this->Internals->ImportRoot(renderer);
+
+  // Textures have been decoding while the node tree was built, wait for them now
+  this->Internals->ResolveTextures();
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
   // Record all actors imported from internals to importer itself
-  for (auto& pair : this->Internals->NodeActors)
+  for (const auto& node : this->Internals->Nodes)
   {
-    vtkCollectionSimpleIterator ait;
-    pair.second->InitTraversal(ait);
-    while (auto* actor = pair.second->GetNextActor(ait))
+    for (vtkActor* actor : node.Actors)
     {
       this->ActorCollection->AddItem(actor);
     }
   }
+  for (vtkActor* actor : this->Internals->BatchedActors)
+  {
+    this->ActorCollection->AddItem(actor);
+  }
 #endif
 }
 
@@ -44,6 +63,12 @@ std::string vtkF3DAssimpImporter::GetOutputsDescription()
 
 //----------------------------------------------------------------------------
 bool vtkF3DAssimpImporter::UpdateAtTimeValue(double timeValue)
+{
+  return this->EvaluateAtTimeValue(timeValue) && this->CommitEvaluatedTimeValue();
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DAssimpImporter::EvaluateAtTimeValue(double timeValue)
 {
   assert(this->Internals->ActiveAnimation < this->GetNumberOfAnimations());
   if (this->Internals->ActiveAnimation == -1)
@@ -52,121 +77,82 @@ bool vtkF3DAssimpImporter::UpdateAtTimeValue(double timeValue)
   }
 
   // get the animation tick
-  double fps =
-    this->Internals->Scene->mAnimations[this->Internals->ActiveAnimation]->mTicksPerSecond;
+  const SceneGraph::Animation& anim =
+    this->Internals->Graph->Animations[this->Internals->ActiveAnimation];
+  double fps = anim.TicksPerSecond;
   if (fps == 0.0)
   {
     fps = 1.0;
   }
 
-  aiAnimation* anim = this->Internals->Scene->mAnimations[this->Internals->ActiveAnimation];
   double tick = timeValue * fps;
 
-  Assimp::Interpolator<aiVectorKey> vectorInterpolator;
-  Assimp::Interpolator<aiQuatKey> quaternionInterpolator;
-
-  for (unsigned int nodeChannelId = 0; nodeChannelId < anim->mNumChannels; nodeChannelId++)
+  if (this->Internals->RestorePose(timeValue))
   {
-    aiNodeAnim* nodeAnim = anim->mChannels[nodeChannelId];
-
-    aiVector3D translation;
-    aiVector3D scaling;
-    aiQuaternion quaternion;
-
-    aiVectorKey* positionKey = std::lower_bound(nodeAnim->mPositionKeys,
-      nodeAnim->mPositionKeys + nodeAnim->mNumPositionKeys, tick,
-      [](const aiVectorKey& key, const double& time) { return key.mTime < time; });
-
-    if (positionKey == nodeAnim->mPositionKeys)
-    {
-      translation = positionKey->mValue;
-    }
-    else if (positionKey == nodeAnim->mPositionKeys + nodeAnim->mNumPositionKeys)
-    {
-      translation = (positionKey - 1)->mValue;
-    }
-    else
-    {
-      aiVectorKey* prev = positionKey - 1;
-      ai_real d = (tick - prev->mTime) / (positionKey->mTime - prev->mTime);
-      vectorInterpolator(translation, *prev, *positionKey, d);
-    }
-
-    aiQuatKey* rotationKey = std::lower_bound(nodeAnim->mRotationKeys,
-      nodeAnim->mRotationKeys + nodeAnim->mNumRotationKeys, tick,
-      [](const aiQuatKey& key, const double& time) { return key.mTime < time; });
-
-    if (rotationKey == nodeAnim->mRotationKeys)
-    {
-      quaternion = rotationKey->mValue;
-    }
-    else if (rotationKey == nodeAnim->mRotationKeys + nodeAnim->mNumRotationKeys)
-    {
-      quaternion = (rotationKey - 1)->mValue;
-    }
-    else
-    {
-      aiQuatKey* prev = rotationKey - 1;
-      ai_real d = (tick - prev->mTime) / (rotationKey->mTime - prev->mTime);
-      quaternionInterpolator(quaternion, *prev, *rotationKey, d);
-    }
-
-    aiVectorKey* scalingKey =
-      std::lower_bound(nodeAnim->mScalingKeys, nodeAnim->mScalingKeys + nodeAnim->mNumScalingKeys,
-        tick, [](const aiVectorKey& key, const double& time) { return key.mTime < time; });
+    return true;
+  }
 
-    if (scalingKey == nodeAnim->mScalingKeys)
-    {
-      scaling = scalingKey->mValue;
-    }
-    else if (scalingKey == nodeAnim->mScalingKeys + nodeAnim->mNumScalingKeys)
-    {
-      scaling = (scalingKey - 1)->mValue;
-    }
-    else
-    {
-      aiVectorKey* prev = scalingKey - 1;
-      ai_real d = (tick - prev->mTime) / (scalingKey->mTime - prev->mTime);
-      vectorInterpolator(scaling, *prev, *scalingKey, d);
-    }
+  if (!this->Internals->EvaluateBakedAnimation(timeValue))
+  {
+    const std::vector<int>& channelNodes =
+      this->Internals->ChannelNodes[this->Internals->ActiveAnimation];
 
-    vtkMatrix4x4* transform = this->Internals->NodeLocalMatrix[nodeAnim->mNodeName.data];
+    std::vector<vtkInternals::ChannelCursor>& cursors = this->Internals->ChannelCursors;
+    cursors.resize(anim.Channels.size());
 
-    if (transform)
+    for (size_t nodeChannelId = 0; nodeChannelId < anim.Channels.size(); nodeChannelId++)
     {
-      // Initialize quaternion
-      vtkQuaternion<double> rotation;
-      rotation.Set(quaternion.w, quaternion.x, quaternion.y, quaternion.z);
-      rotation.Normalize();
-
-      double rotationMatrix[3][3];
-      rotation.ToMatrix3x3(rotationMatrix);
-
-      // Apply transformations
-      for (int i = 0; i < 3; i++)
+      int nodeIndex = channelNodes[nodeChannelId];
+      if (nodeIndex >= 0)
       {
-        for (int j = 0; j < 3; j++)
-        {
-          transform->SetElement(i, j, scaling[j] * rotationMatrix[i][j]);
-        }
-        transform->SetElement(i, 3, translation[i]);
+        const SceneGraph::Channel& channel = anim.Channels[nodeChannelId];
+        vtkInternals::ChannelCursor& cursor = cursors[nodeChannelId];
+
+        aiVector3D translation = vtkInternals::SampleKeys(
+          channel.PositionKeys, tick, cursor.Position, aiVector3D(0, 0, 0));
+        aiQuaternion quaternion =
+          vtkInternals::SampleKeys(channel.RotationKeys, tick, cursor.Rotation, aiQuaternion());
+        aiVector3D scaling =
+          vtkInternals::SampleKeys(channel.ScalingKeys, tick, cursor.Scaling, aiVector3D(1, 1, 1));
+
+        double t[3] = { translation.x, translation.y, translation.z };
+        double q[4] = { quaternion.w, quaternion.x, quaternion.y, quaternion.z };
+        double s[3] = { scaling.x, scaling.y, scaling.z };
+        vtkInternals::ComposeLocalMatrix(this->Internals->Nodes[nodeIndex].LocalMatrix, t, q, s);
       }
     }
   }
 
-  vtkNew<vtkMatrix4x4> identity;
-  this->Internals->UpdateNodeTransform(this->Internals->Scene->mRootNode, identity);
+  this->Internals->EvaluateMorphWeights(tick);
+  this->Internals->UpdateNodeTransforms();
+  this->Internals->EvaluateBones();
+  this->Internals->StorePose(timeValue);
+  return true;
+}
 
-  this->Internals->UpdateBones();
-  this->Internals->UpdateCameras();
-  this->Internals->UpdateLights();
+//----------------------------------------------------------------------------
+bool vtkF3DAssimpImporter::CommitEvaluatedTimeValue()
+{
+  this->Internals->CommitPose();
   return true;
 }
 
+//----------------------------------------------------------------------------
+std::shared_ptr<const vtkF3DAssimpImporter::SceneGraph> vtkF3DAssimpImporter::GetSceneGraph()
+{
+  return this->Internals->Graph;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkF3DAssimpImporter::GetNumberOfUpdatedNodes()
+{
+  return this->Internals->NumberOfUpdatedNodes;
+}
+
 //----------------------------------------------------------------------------
 vtkIdType vtkF3DAssimpImporter::GetNumberOfAnimations()
 {
-  return this->Internals->Scene ? this->Internals->Scene->mNumAnimations : 0;
+  return static_cast<vtkIdType>(this->Internals->Graph->Animations.size());
 }
 
 //----------------------------------------------------------------------------
@@ -174,7 +160,7 @@ std::string vtkF3DAssimpImporter::GetAnimationName(vtkIdType animationIndex)
 {
   assert(animationIndex < this->GetNumberOfAnimations());
   assert(animationIndex >= 0);
-  return this->Internals->Scene->mAnimations[animationIndex]->mName.C_Str();
+  return this->Internals->Graph->Animations[animationIndex].Name;
 }
 
 //----------------------------------------------------------------------------
@@ -182,13 +168,20 @@ void vtkF3DAssimpImporter::EnableAnimation(vtkIdType animationIndex)
 {
   assert(animationIndex < this->GetNumberOfAnimations());
   assert(animationIndex >= 0);
+  if (this->Internals->ActiveAnimation != animationIndex)
+  {
+    this->Internals->ClearPoseCache();
+  }
   this->Internals->ActiveAnimation = animationIndex;
+  this->Internals->BakeAnimation();
+  this->Internals->AssignMorphSlots();
 }
 
 //----------------------------------------------------------------------------
 void vtkF3DAssimpImporter::DisableAnimation(vtkIdType vtkNotUsed(animationIndex))
 {
   this->Internals->ActiveAnimation = -1;
+  this->Internals->ClearPoseCache();
 }
 
 //----------------------------------------------------------------------------
@@ -207,8 +200,8 @@ bool vtkF3DAssimpImporter::GetTemporalInformation(vtkIdType animationIndex,
   assert(animationIndex < this->GetNumberOfAnimations());
   assert(animationIndex >= 0);
 
-  double duration = this->Internals->Scene->mAnimations[animationIndex]->mDuration;
-  double fps = this->Internals->Scene->mAnimations[animationIndex]->mTicksPerSecond;
+  double duration = this->Internals->Graph->Animations[animationIndex].Duration;
+  double fps = this->Internals->Graph->Animations[animationIndex].TicksPerSecond;
   if (fps == 0.0)
   {
     fps = 1.0;
@@ -258,6 +251,12 @@ void vtkF3DAssimpImporter::ImportLights(vtkRenderer* renderer)
   this->Internals->ImportLights(renderer);
 }
 
+//----------------------------------------------------------------------------
+void vtkF3DAssimpImporter::ImportEnd()
+{
+  this->Internals->ReleaseScene();
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DAssimpImporter::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -16,7 +16,14 @@
 
 #include <vtkVersion.h>
 
+#include <assimp/anim.h>
+
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class vtkInformationObjectBaseKey;
 
 class vtkF3DAssimpImporter : public vtkF3DImporter
 {
@@ -33,11 +40,36 @@ public:
   vtkGetMacro(FileName, std::string);
   ///@}
 
+  /**
+   * Parse the file and convert its meshes, materials and textures without creating
+   * any actor. This does not need a render window and can be called from a worker
+   * thread, updating the importer afterwards then only creates the actors.
+   * ProgressEvent is invoked from the calling thread while the file is parsed.
+   * Returns false on failure or if the import was aborted.
+   */
+  bool Preload();
+
+  /**
+   * Request the file parsing in progress to stop as soon as possible.
+   * Can be called from any thread. Preload, or the next update, then fails.
+   */
+  void AbortImport();
+
   /**
    * Update actors at the given time value.
    */
   bool UpdateAtTimeValue(double timeValue) override;
 
+  ///@{
+  /**
+   * Evaluate the node transforms, joint palettes and morph weights at the given time value,
+   * then apply them to the actors, cameras and lights.
+   * Evaluation does not modify anything used by the renderer.
+   */
+  bool EvaluateAtTimeValue(double timeValue) override;
+  bool CommitEvaluatedTimeValue() override;
+  ///@}
+
   /**
    * Get the level of animation support in this importer, which is always
    * AnimationSupportLevel::SINGLE
@@ -83,6 +115,226 @@ public:
   vtkGetMacro(ColladaFixup, bool);
   ///@}
 
+  ///@{
+  /**
+   * Set/Get additional Assimp post processing steps, as aiPostProcessSteps flags,
+   * applied after the ones always applied by the importer.
+   * Steps are applied one by one, in the order Assimp would apply them, and the time
+   * and vertex, face and mesh counts of each step are reported in the importer description.
+   * Steps the importer does not know the order of are applied together at the end.
+   * Default is 0.
+   */
+  vtkSetMacro(PostProcessSteps, unsigned int);
+  vtkGetMacro(PostProcessSteps, unsigned int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the maximum number of threads used to convert meshes, embedded textures
+   * and materials after Assimp parsing.
+   * 0 means the vtkSMPTools default, 1 forces a serial conversion.
+   * Default is 0.
+   */
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfThreads, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get if the points, normals, tangents and colors arrays should wrap the
+   * Assimp buffers directly instead of copying them.
+   * The arrays then keep the Assimp importer alive through the ASSIMP_BUFFER_OWNER key.
+   * The Assimp scene is therefore kept in memory after the import instead of being
+   * released, trading the memory saved by not copying the arrays for the whole scene.
+   * Has no effect when Assimp is built with double precision.
+   * Default is false.
+   */
+  vtkSetMacro(AdoptAssimpBuffers, bool);
+  vtkGetMacro(AdoptAssimpBuffers, bool);
+  vtkBooleanMacro(AdoptAssimpBuffers, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the rate, in samples per second, at which an animation is resampled
+   * into contiguous buffers when it is enabled.
+   * Frames are then evaluated by interpolating the two nearest samples of all channels
+   * at once instead of searching and interpolating the keys of each channel,
+   * which is faster but only exact at sample times.
+   * 0 disables baking. Default is 0.
+   */
+  vtkSetClampMacro(AnimationBakingRate, double, 0, VTK_DOUBLE_MAX);
+  vtkGetMacro(AnimationBakingRate, double);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the maximum memory, in bytes, used by the samples of a baked animation.
+   * Animations needing more are not baked and their keys are interpolated instead.
+   * Default is 256 MiB.
+   */
+  vtkSetMacro(AnimationBakingBudget, vtkIdType);
+  vtkGetMacro(AnimationBakingBudget, vtkIdType);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the maximum number of evaluated poses of the active animation kept in memory.
+   * A pose is the global matrices of all nodes, the joint palettes and the morph weights.
+   * Only the poses evaluated while seeking, see vtkF3DImporter::SetSeeking, are stored
+   * and restored. Evaluating a time whose pose is cached only copies it back, which makes
+   * scrubbing over an already visited range instant.
+   * The least recently used pose is discarded when the cache is full.
+   * 0 disables the cache. Default is 0.
+   */
+  vtkSetClampMacro(PoseCacheSize, int, 0, VTK_INT_MAX);
+  vtkGetMacro(PoseCacheSize, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the time step, in seconds, of the keys of the pose cache.
+   * Poses are keyed by their time rounded to this step, so seeks within a step share
+   * the pose of the first one. It is best set to the animation frame duration, as
+   * a seek then shows the pose of a time less than half a frame away.
+   * Default is 0.001.
+   */
+  vtkSetClampMacro(PoseCacheTimeStep, double, 1e-6, VTK_DOUBLE_MAX);
+  vtkGetMacro(PoseCacheTimeStep, double);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the number of decimated levels of detail generated for each large mesh.
+   * Each level keeps a quarter of the triangles of the previous one, and is provided
+   * to the renderer through the vtkF3DImporter::ACTOR_LOD_MAPPERS key of the actors.
+   * Only triangle meshes that are neither skinned nor morphed are decimated.
+   * 0 disables the generation. Default is 0.
+   */
+  vtkSetClampMacro(NumberOfLODs, int, 0, 4);
+  vtkGetMacro(NumberOfLODs, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get if meshes of nodes not animated by any animation channel should be batched.
+   * Their geometry is transformed to world space and merged by material in a single actor,
+   * reducing the number of draw calls for scenes made of many small static meshes.
+   * Each cell keeps the index of its node in the "NodeId" cell data array.
+   * Skinned and morphed meshes are never batched.
+   * Default is false.
+   */
+  vtkSetMacro(BatchStaticMeshes, bool);
+  vtkGetMacro(BatchStaticMeshes, bool);
+  vtkBooleanMacro(BatchStaticMeshes, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the directory used to cache converted scenes.
+   * When set, the post processed scene and its converted meshes are stored in a file
+   * named after the hash of the imported file, written in the background. When a file
+   * with the same content is imported later with the same import settings, the scene
+   * is mapped from it and Assimp does not read the file at all.
+   * The hash of a file is only computed again when its size or modification time change.
+   * Empty disables the cache. Default is empty.
+   */
+  vtkSetMacro(CachePath, std::string);
+  vtkGetMacro(CachePath, std::string);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the maximum size in bytes of the cache directory.
+   * The least recently used scenes are removed when a new one is written.
+   * Default is 1 GiB.
+   */
+  vtkSetClampMacro(CacheBudget, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(CacheBudget, vtkIdType);
+  ///@}
+
+  /**
+   * Compact copy of the imported scene graph.
+   * The Assimp scene is released once the actors are created, unless some arrays
+   * wrap its buffers, so this is what remains available to describe the scene afterwards.
+   * Nodes are stored in depth first order, parents before their children.
+   */
+  struct SceneGraph
+  {
+    struct Node
+    {
+      std::string Name;
+      int Parent = -1;
+      std::vector<int> Children;
+      unsigned int NumberOfMeshes = 0;
+    };
+
+    struct Bone
+    {
+      std::string Name;
+      int Node = -1; // -1 if no node has the bone name
+      unsigned int Mesh = 0;
+      unsigned int NumberOfWeights = 0;
+      double OffsetMatrix[16]; // row major
+    };
+
+    struct Channel
+    {
+      std::string NodeName;
+      std::vector<aiVectorKey> PositionKeys;
+      std::vector<aiQuatKey> RotationKeys;
+      std::vector<aiVectorKey> ScalingKeys;
+    };
+
+    struct MorphKey
+    {
+      double Time = 0;
+      std::vector<unsigned int> Targets; // indices of the morph targets of the node meshes
+      std::vector<double> Weights;
+    };
+
+    struct MorphChannel
+    {
+      std::string NodeName;
+      std::vector<MorphKey> Keys;
+    };
+
+    struct Animation
+    {
+      std::string Name;
+      double Duration = 0;
+      double TicksPerSecond = 0;
+      std::vector<Channel> Channels;
+      std::vector<MorphChannel> MorphChannels;
+    };
+
+    std::vector<Node> Nodes;
+    std::vector<Bone> Bones;
+    std::vector<Animation> Animations;
+
+    // indices in Bones of the bones of each node, most weights first, nodes without bones
+    // are not listed
+    std::unordered_map<int, std::vector<int>> NodeBones;
+  };
+
+  /**
+   * Get the scene graph of the imported file, empty before the actors are imported.
+   * The returned snapshot is never modified and stays valid after the next import.
+   */
+  std::shared_ptr<const SceneGraph> GetSceneGraph();
+
+  /**
+   * Information key set on arrays wrapping Assimp buffers.
+   * It stores the object owning the Assimp importer these buffers belong to.
+   */
+  static vtkInformationObjectBaseKey* ASSIMP_BUFFER_OWNER();
+
+  /**
+   * Get the number of nodes whose global transform was recomputed by the last call
+   * to UpdateAtTimeValue. Nodes whose local transform and parents did not change are skipped.
+   */
+  vtkIdType GetNumberOfUpdatedNodes();
+
   /**
    * Get temporal information for the currently enabled animation.
    * Only defines timerange and ignore provided frameRate.
@@ -114,9 +366,21 @@ protected:
   void ImportActors(vtkRenderer*) override;
   void ImportCameras(vtkRenderer*) override;
   void ImportLights(vtkRenderer*) override;
+  void ImportEnd() override;
 
   std::string FileName;
   bool ColladaFixup = false;
+  unsigned int PostProcessSteps = 0;
+  int NumberOfThreads = 0;
+  bool AdoptAssimpBuffers = false;
+  std::string CachePath;
+  vtkIdType CacheBudget = vtkIdType(1024) << 20;
+  double AnimationBakingRate = 0;
+  vtkIdType AnimationBakingBudget = vtkIdType(256) << 20;
+  int PoseCacheSize = 0;
+  double PoseCacheTimeStep = 0.001;
+  bool BatchStaticMeshes = false;
+  int NumberOfLODs = 0;
 
 // b private:
 public:
@@ -127,14 +391,29 @@ public:
   std::unique_ptr<vtkInternals> Internals;
 };
 
+#include "F3DMeshCache.h"
+#include "F3DTextureCache.h"
+#include "F3DUtils.h"
+
 #include <vtkActor.h>
 #include <vtkActorCollection.h>
+#include <vtkAppendPolyData.h>
+#include <vtkBoundingBox.h>
 #include <vtkCamera.h>
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
+#include <vtkCommand.h>
 #include <vtkDoubleArray.h>
 #include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
 #include <vtkImageData.h>
 #include <vtkImageReader2.h>
+#include <vtkImageReader2Collection.h>
 #include <vtkImageReader2Factory.h>
+#include <vtkInformation.h>
+#include <vtkInformationDoubleVectorKey.h>
+#include <vtkInformationObjectBaseKey.h>
+#include <vtkInformationObjectBaseVectorKey.h>
 #include <vtkLight.h>
 #include <vtkMatrix4x4.h>
 #include <vtkObjectFactory.h>
@@ -144,12 +423,15 @@ public:
 #include <vtkPolyDataMapper.h>
 #include <vtkPolyDataTangents.h>
 #include <vtkProperty.h>
+#include <vtkQuadricDecimation.h>
 #include <vtkQuaternion.h>
 #include <vtkRenderer.h>
+#include <vtkSMPTools.h>
 #include <vtkShaderProperty.h>
 #include <vtkSmartPointer.h>
 #include <vtkStringArray.h>
 #include <vtkTexture.h>
+#include <vtkTimerLog.h>
 #include <vtkTransform.h>
 #include <vtkTriangleFilter.h>
 #include <vtkUniforms.h>
@@ -159,11 +441,81 @@ public:
 
 #include <assimp/Exceptional.h>
 #include <assimp/Importer.hpp>
+#include <assimp/ProgressHandler.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
+#include <assimp/version.h>
 
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define F3D_ASSIMP_USE_SSE
+#include <xmmintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <regex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Keep an Assimp importer, and therefore its scene buffers, alive
+ * as long as a VTK array wrapping one of these buffers is alive.
+ */
+class vtkF3DAssimpBufferOwner : public vtkObject
+{
+public:
+    static vtkF3DAssimpBufferOwner* New();
+    vtkTypeMacro(vtkF3DAssimpBufferOwner, vtkObject);
+
+    std::shared_ptr<Assimp::Importer> Importer;
+
+protected:
+    vtkF3DAssimpBufferOwner() = default;
+    ~vtkF3DAssimpBufferOwner() override = default;
+
+private:
+    vtkF3DAssimpBufferOwner(const vtkF3DAssimpBufferOwner&) = delete;
+    void operator=(const vtkF3DAssimpBufferOwner&) = delete;
+};
+
+/**
+ * Forward Assimp parsing progress as VTK ProgressEvent on the importer
+ * and abort the parsing when requested.
+ */
+class vtkF3DAssimpProgressHandler : public Assimp::ProgressHandler
+{
+public:
+    vtkF3DAssimpProgressHandler(vtkF3DAssimpImporter* importer, const std::atomic<bool>& abort)
+        : Importer(importer)
+        , Abort(abort)
+    {
+    }
+
+    bool Update(float percentage) override
+    {
+        // parsing is reported as the first 90%, conversion as the rest
+        double progress = 0.9 * std::clamp(static_cast<double>(percentage), 0.0, 1.0);
+        this->Importer->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+        return !this->Abort;
+    }
+
+private:
+    vtkF3DAssimpImporter* Importer;
+    const std::atomic<bool>& Abort;
+};
 
 class vtkF3DAssimpImporter::vtkInternals
 {
@@ -194,10 +546,11 @@ public:
                 // Store the non transformed camera alongside another camera that will be initialized later
                 vtkNew<vtkCamera> transformedCam;
                 this->Cameras.push_back({ aCam->mName.data, { vCam, transformedCam } });
+                this->CameraNodes.push_back(this->FindNode(aCam->mName.data));
             }
 
             // update transformed camera using global matrix nodes and non transformed cameras
-            this->UpdateCameras();
+            this->UpdateCameras(true);
 
             if (this->ActiveCameraIndex >= 0 &&
                 this->ActiveCameraIndex < static_cast<vtkIdType>(this->Cameras.size()))
@@ -277,17 +630,32 @@ public:
 
                     renderer->AddLight(light);
                     this->Lights.emplace_back(aLight->mName.data, light);
+                    this->LightNodes.push_back(this->FindNode(aLight->mName.data));
                 }
             }
 
             // update light global matrix nodes
-            this->UpdateLights();
+            this->UpdateLights(true);
         }
     }
 
     //----------------------------------------------------------------------------
     /**
-     * Generate a VTK texture from a file path
+     * Set the sampling parameters of a texture used by a material
+     */
+    static void ConfigureTexture(vtkTexture* texture, bool sRGB)
+    {
+        texture->MipmapOn();
+        texture->InterpolateOn();
+        texture->SetColorModeToDirectScalars();
+        texture->SetUseSRGBColorSpace(sRGB);
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Generate a VTK texture from a file path.
+     * Materials are created in parallel, shared textures are configured once under
+     * TexturesMutex and keyed by color space, so they are never modified concurrently.
      */
     vtkSmartPointer<vtkTexture> CreateTexture(const char* path, bool sRGB = false)
     {
@@ -297,66 +665,128 @@ public:
         {
             int texIndex = std::atoi(path + 1);
 
-            if (texIndex >= 0 && texIndex < static_cast<int>(this->EmbeddedTextures.size()))
+            if (texIndex >= 0 && texIndex < static_cast<int>(this->EmbeddedTextures.size()) &&
+                this->EmbeddedTextures[texIndex])
             {
-                vTexture = this->EmbeddedTextures[texIndex];
+                // materials sharing an embedded texture share its decoded image
+                std::lock_guard<std::mutex> lock(this->TexturesMutex);
+                vtkSmartPointer<vtkTexture>& shared = this->SharedEmbeddedTextures[{ texIndex, sRGB }];
+                if (!shared)
+                {
+                    shared = vtkSmartPointer<vtkTexture>::New();
+                    shared->SetInputData(this->EmbeddedTextures[texIndex]->GetInput());
+                    ConfigureTexture(shared, sRGB);
+                }
+                return shared;
             }
         }
 
-        if (!vTexture)
+        // sometimes, embedded textures are indexed by filename
+        const aiTexture* aTexture = this->Scene->GetEmbeddedTexture(path);
+
+        if (aTexture)
+        {
+            // not shared, created for this material only
+            vTexture = this->CreateEmbeddedTexture(aTexture);
+            ConfigureTexture(vTexture, sRGB);
+        }
+        else
         {
-            // sometimes, embedded textures are indexed by filename
-            const aiTexture* aTexture = this->Scene->GetEmbeddedTexture(path);
+            std::string dir = vtksys::SystemTools::GetParentDirectory(this->Parent->GetFileName());
+            std::string texturePath = vtksys::SystemTools::CollapseFullPath(path, dir);
 
-            if (aTexture)
+            // try to get the texture in the same dir as the model file
+            if (!vtksys::SystemTools::FileExists(texturePath))
             {
-                vTexture = this->CreateEmbeddedTexture(aTexture);
+                std::string fileName = vtksys::SystemTools::GetFilenameName(path);
+                texturePath = vtksys::SystemTools::CollapseFullPath(fileName, dir);
             }
-            else
+
+            if (vtksys::SystemTools::FileExists(texturePath))
             {
-                std::string dir = vtksys::SystemTools::GetParentDirectory(this->Parent->GetFileName());
-                std::string texturePath = vtksys::SystemTools::CollapseFullPath(path, dir);
+                std::lock_guard<std::mutex> lock(this->TexturesMutex);
+                this->TextureRequests++;
 
-                // try to get the texture in the same dir as the model file
-                if (!vtksys::SystemTools::FileExists(texturePath))
+                // materials sharing a texture file share the same texture
+                auto fileTexture = this->FileTextures.find({ texturePath, sRGB });
+                if (fileTexture != this->FileTextures.end())
                 {
-                    std::string fileName = vtksys::SystemTools::GetFilenameName(path);
-                    texturePath = vtksys::SystemTools::CollapseFullPath(fileName, dir);
+                    return fileTexture->second;
                 }
 
-                if (vtksys::SystemTools::FileExists(texturePath))
-                {
-                    vtkSmartPointer<vtkImageReader2> reader;
-                    reader.TakeReference(vtkImageReader2Factory::CreateImageReader2(texturePath.c_str()));
+                vtkSmartPointer<vtkImageReader2> reader;
+                reader.TakeReference(vtkImageReader2Factory::CreateImageReader2(texturePath.c_str()));
 
-                    if (!reader)
-                    {
-                        vtkWarningWithObjectMacro(
-                            this->Parent, "Cannot instantiate the image reader for texture: " << texturePath);
-                        return nullptr;
-                    }
+                if (!reader)
+                {
+                    this->Warn("Cannot instantiate the image reader for texture: " + texturePath);
+                    return nullptr;
+                }
 
-                    reader->SetFileName(texturePath.c_str());
+                reader->SetFileName(texturePath.c_str());
 
-                    vTexture = vtkSmartPointer<vtkTexture>::New();
-                    vTexture->SetInputConnection(reader->GetOutputPort());
-                }
-                else
+                // decoding is done asynchronously and resolved in ResolveTextures
+                bool hit = false;
+                F3DTextureCache::ImageFuture image =
+                    F3DTextureCache::GetInstance().Request(texturePath, reader, hit);
+                if (hit)
                 {
-                    vtkWarningWithObjectMacro(this->Parent, "Cannot find texture: " << texturePath);
-                    return nullptr;
+                    this->TextureCacheHits++;
                 }
+
+                vTexture = vtkSmartPointer<vtkTexture>::New();
+                ConfigureTexture(vTexture, sRGB);
+                this->PendingTextures.push_back({ vTexture, image, texturePath });
+                this->FileTextures[{ texturePath, sRGB }] = vTexture;
+            }
+            else
+            {
+                this->Warn("Cannot find texture: " + texturePath);
+                return nullptr;
             }
         }
 
-        vTexture->MipmapOn();
-        vTexture->InterpolateOn();
-        vTexture->SetColorModeToDirectScalars();
-        vTexture->SetUseSRGBColorSpace(sRGB);
-
         return vTexture;
     }
 
+    //----------------------------------------------------------------------------
+    /**
+     * Wait for the textures decoded asynchronously and plug them into their VTK texture
+     */
+    void ResolveTextures()
+    {
+        for (PendingTexture& pending : this->PendingTextures)
+        {
+            vtkSmartPointer<vtkImageData> image = pending.Image.get();
+            if (!image)
+            {
+                vtkWarningWithObjectMacro(this->Parent, "Cannot decode texture: " << pending.Path);
+
+                // use a white texel so the material is still rendered
+                image = vtkSmartPointer<vtkImageData>::New();
+                image->SetDimensions(1, 1, 1);
+                image->AllocateScalars(VTK_UNSIGNED_CHAR, 4);
+                std::fill_n(static_cast<unsigned char*>(image->GetScalarPointer()), 4, 255);
+            }
+            pending.Texture->SetInputData(image);
+        }
+
+        if (this->TextureRequests > 0)
+        {
+            this->Description += "Texture files: ";
+            this->Description += std::to_string(this->TextureRequests);
+            this->Description += " references, ";
+            this->Description += std::to_string(this->PendingTextures.size());
+            this->Description += " unique, ";
+            this->Description += std::to_string(this->TextureCacheHits);
+            this->Description += " reused from cache, ";
+            this->Description += std::to_string(this->PendingTextures.size() - this->TextureCacheHits);
+            this->Description += " decoded\n";
+        }
+
+        this->PendingTextures.clear();
+    }
+
     //----------------------------------------------------------------------------
     /**
      * Generate a VTK texture from an embedded ASSIMP texture
@@ -377,7 +807,12 @@ public:
             {
                 reader->SetMemoryBuffer(aTexture->pcData);
                 reader->SetMemoryBufferLength(aTexture->mWidth);
-                vTexture->SetInputConnection(reader->GetOutputPort());
+
+                // decode now, the Assimp buffer does not outlive the import
+                reader->Update();
+                vtkNew<vtkImageData> img;
+                img->ShallowCopy(reader->GetOutput());
+                vTexture->SetInputData(img);
             }
         }
         else
@@ -505,6 +940,64 @@ public:
         return property;
     }
 
+    //----------------------------------------------------------------------------
+    /**
+     * Return true if Assimp buffers can be wrapped by VTK float arrays
+     */
+    bool CanAdoptBuffers() const
+    {
+#ifdef ASSIMP_DOUBLE_PRECISION
+        return false;
+#else
+        return this->Parent->GetAdoptAssimpBuffers();
+#endif
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Wrap an Assimp float buffer into a VTK array without copying it.
+     * The array is flagged to never free the buffer and keeps the importer alive.
+     */
+    vtkSmartPointer<vtkFloatArray> AdoptBuffer(void* buffer, vtkIdType nbTuples, int nbComponents)
+    {
+        vtkNew<vtkFloatArray> array;
+        array->SetNumberOfComponents(nbComponents);
+        array->SetArray(static_cast<float*>(buffer), nbTuples * nbComponents, 1);
+        array->GetInformation()->Set(
+            vtkF3DAssimpImporter::ASSIMP_BUFFER_OWNER(), this->GetBufferOwner());
+        return array;
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Get the object keeping the current Assimp importer alive, created by ReadScene
+     */
+    vtkF3DAssimpBufferOwner* GetBufferOwner() const
+    {
+        return this->BufferOwner;
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Create the buffer owner of the scene about to be read, when buffers are adopted.
+     * The arrays of a previously read scene may still wrap the buffers of the current
+     * importer, a new importer is used in that case so they stay valid.
+     */
+    void ResetBufferOwner(bool adoptBuffers)
+    {
+        if (this->BufferOwner)
+        {
+            this->Importer = std::make_shared<Assimp::Importer>();
+            this->BufferOwner = nullptr;
+        }
+
+        if (adoptBuffers)
+        {
+            this->BufferOwner = vtkSmartPointer<vtkF3DAssimpBufferOwner>::New();
+            this->BufferOwner->Importer = this->Importer;
+        }
+    }
+
     //----------------------------------------------------------------------------
     /**
      * Generate a VTK polyData from ASSIMP mesh
@@ -514,30 +1007,46 @@ public:
         vtkNew<vtkPolyData> polyData;
 
         vtkNew<vtkPoints> points;
-        points->SetNumberOfPoints(mesh->mNumVertices);
-        for (unsigned int i = 0; i < mesh->mNumVertices; i++)
+        if (this->CanAdoptBuffers())
+        {
+            points->SetData(this->AdoptBuffer(mesh->mVertices, mesh->mNumVertices, 3));
+        }
+        else
         {
-            const aiVector3D& p = mesh->mVertices[i];
-            points->SetPoint(i, p.x, p.y, p.z);
+            points->SetNumberOfPoints(mesh->mNumVertices);
+            for (unsigned int i = 0; i < mesh->mNumVertices; i++)
+            {
+                const aiVector3D& p = mesh->mVertices[i];
+                points->SetPoint(i, p.x, p.y, p.z);
+            }
         }
         polyData->SetPoints(points);
 
         if (mesh->HasNormals())
         {
-            vtkNew<vtkFloatArray> normals;
-            normals->SetNumberOfComponents(3);
-            normals->SetName("Normal");
-            normals->SetNumberOfTuples(mesh->mNumVertices);
-            for (unsigned int i = 0; i < mesh->mNumVertices; i++)
+            vtkSmartPointer<vtkFloatArray> normals;
+            if (this->CanAdoptBuffers())
+            {
+                normals = this->AdoptBuffer(mesh->mNormals, mesh->mNumVertices, 3);
+            }
+            else
             {
-                const aiVector3D& n = mesh->mNormals[i];
-                float tuple[3] = { n.x, n.y, n.z };
-                normals->SetTypedTuple(i, tuple);
+                normals = vtkSmartPointer<vtkFloatArray>::New();
+                normals->SetNumberOfComponents(3);
+                normals->SetNumberOfTuples(mesh->mNumVertices);
+                for (unsigned int i = 0; i < mesh->mNumVertices; i++)
+                {
+                    const aiVector3D& n = mesh->mNormals[i];
+                    float tuple[3] = { n.x, n.y, n.z };
+                    normals->SetTypedTuple(i, tuple);
+                }
             }
+            normals->SetName("Normal");
             polyData->GetPointData()->SetNormals(normals);
         }
 
         // currently, VTK only supports 1 texture coordinates
+        // Assimp always stores 3 components per UV so they cannot be adopted
         const unsigned int textureIndex = 0;
         if (mesh->HasTextureCoords(textureIndex) && mesh->mNumUVComponents[textureIndex] == 2)
         {
@@ -556,31 +1065,47 @@ public:
 
         if (mesh->HasTangentsAndBitangents())
         {
-            vtkNew<vtkFloatArray> tangents;
-            tangents->SetNumberOfComponents(3);
-            tangents->SetName("Tangents");
-            tangents->SetNumberOfTuples(mesh->mNumVertices);
-            for (unsigned int i = 0; i < mesh->mNumVertices; i++)
+            vtkSmartPointer<vtkFloatArray> tangents;
+            if (this->CanAdoptBuffers())
+            {
+                tangents = this->AdoptBuffer(mesh->mTangents, mesh->mNumVertices, 3);
+            }
+            else
             {
-                const aiVector3D& t = mesh->mTangents[i];
-                float tuple[3] = { t.x, t.y, t.z };
-                tangents->SetTypedTuple(i, tuple);
+                tangents = vtkSmartPointer<vtkFloatArray>::New();
+                tangents->SetNumberOfComponents(3);
+                tangents->SetNumberOfTuples(mesh->mNumVertices);
+                for (unsigned int i = 0; i < mesh->mNumVertices; i++)
+                {
+                    const aiVector3D& t = mesh->mTangents[i];
+                    float tuple[3] = { t.x, t.y, t.z };
+                    tangents->SetTypedTuple(i, tuple);
+                }
             }
+            tangents->SetName("Tangents");
             polyData->GetPointData()->SetTangents(tangents);
         }
 
         if (mesh->HasVertexColors(0))
         {
-            vtkNew<vtkFloatArray> colors;
-            colors->SetNumberOfComponents(4);
-            colors->SetName("Colors");
-            colors->SetNumberOfTuples(mesh->mNumVertices);
-            for (unsigned int i = 0; i < mesh->mNumVertices; i++)
+            vtkSmartPointer<vtkFloatArray> colors;
+            if (this->CanAdoptBuffers())
+            {
+                colors = this->AdoptBuffer(mesh->mColors[0], mesh->mNumVertices, 4);
+            }
+            else
             {
-                const aiColor4D& c = mesh->mColors[0][i];
-                float tuple[4] = { c.r, c.g, c.b, c.a };
-                colors->SetTypedTuple(i, tuple);
+                colors = vtkSmartPointer<vtkFloatArray>::New();
+                colors->SetNumberOfComponents(4);
+                colors->SetNumberOfTuples(mesh->mNumVertices);
+                for (unsigned int i = 0; i < mesh->mNumVertices; i++)
+                {
+                    const aiColor4D& c = mesh->mColors[0][i];
+                    float tuple[4] = { c.r, c.g, c.b, c.a };
+                    colors->SetTypedTuple(i, tuple);
+                }
             }
+            colors->SetName("Colors");
             polyData->GetPointData()->SetScalars(colors);
         }
 
@@ -690,6 +1215,55 @@ public:
             polyData->GetFieldData()->AddArray(bonesTransform);
         }
 
+        if (mesh->mNumAnimMeshes > 0)
+        {
+            // morph targets are stored as offsets from the base mesh, the mapper adds
+            // them to the points and normals weighted by the morphWeights uniform
+            vtkNew<vtkStringArray> targetNames;
+            targetNames->SetName("MorphTargets");
+
+            vtkNew<vtkFloatArray> targetWeights;
+            targetWeights->SetName("MorphWeights");
+
+            for (unsigned int i = 0; i < mesh->mNumAnimMeshes; i++)
+            {
+                const aiAnimMesh* animMesh = mesh->mAnimMeshes[i];
+                std::string prefix = "MorphTarget" + std::to_string(i);
+
+                auto addOffsets = [&](const aiVector3D* target, const aiVector3D* base,
+                                      const std::string& name)
+                {
+                    vtkNew<vtkFloatArray> offsets;
+                    offsets->SetName(name.c_str());
+                    offsets->SetNumberOfComponents(3);
+                    offsets->SetNumberOfTuples(mesh->mNumVertices);
+                    for (unsigned int j = 0; j < mesh->mNumVertices; j++)
+                    {
+                        aiVector3D d = target[j] - base[j];
+                        float tuple[3] = { d.x, d.y, d.z };
+                        offsets->SetTypedTuple(j, tuple);
+                    }
+                    polyData->GetPointData()->AddArray(offsets);
+                };
+
+                if (animMesh->mNumVertices == mesh->mNumVertices && animMesh->HasPositions())
+                {
+                    addOffsets(animMesh->mVertices, mesh->mVertices, prefix + "_position");
+                }
+                if (animMesh->mNumVertices == mesh->mNumVertices && animMesh->HasNormals() &&
+                    mesh->HasNormals())
+                {
+                    addOffsets(animMesh->mNormals, mesh->mNormals, prefix + "_normal");
+                }
+
+                targetNames->InsertNextValue(animMesh->mName.C_Str());
+                targetWeights->InsertNextValue(animMesh->mWeight);
+            }
+
+            polyData->GetFieldData()->AddArray(targetNames);
+            polyData->GetFieldData()->AddArray(targetWeights);
+        }
+
         if (mesh->HasNormals() && mesh->HasTextureCoords(0) && !mesh->HasTangentsAndBitangents())
         {
             // Let's compute tangents ourselves
@@ -709,55 +1283,511 @@ public:
 
     //----------------------------------------------------------------------------
     /**
-     * Read the scene file
+     * Messages of the ParallelFor task running on the current thread, nullptr outside of tasks
      */
-    bool ReadScene(const std::string& filePath)
+    static std::vector<std::string>*& TaskWarnings()
+    {
+        static thread_local std::vector<std::string>* warnings = nullptr;
+        return warnings;
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Emit a warning. Within a ParallelFor task it is kept with the task and emitted
+     * once the loop is done, as VTK output windows are not thread safe.
+     */
+    void Warn(const std::string& message)
     {
-        try
+        std::vector<std::string>* warnings = TaskWarnings();
+        if (warnings)
         {
-            // Work around for https://github.com/assimp/assimp/issues/4620
-            this->Importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS, false);
-            this->Scene = this->Importer.ReadFile(
-                filePath, aiProcess_LimitBoneWeights 
-                | aiProcess_Triangulate // b
-                | aiProcess_PopulateArmatureData // b
-                | aiProcess_ValidateDataStructure);
+            warnings->emplace_back(message);
         }
-        catch (const DeadlyImportError& e)
+        else
         {
-            vtkErrorWithObjectMacro(this->Parent, "Assimp exception: " << e.what());
-            return false;
+            vtkWarningWithObjectMacro(this->Parent, << message);
         }
+    }
 
-        if (this->Scene)
-        {
-            // convert meshes to polyData
-            this->Meshes.resize(this->Scene->mNumMeshes);
-            for (unsigned int i = 0; i < this->Scene->mNumMeshes; i++)
-            {
-                this->Meshes[i] = this->CreateMesh(this->Scene->mMeshes[i]);
+    //----------------------------------------------------------------------------
+    /**
+     * Count an item converted by ConvertScene. The progress is reported by the thread
+     * that started the conversion only, when it changed by at least 1%.
+     */
+    void AdvanceConversion()
+    {
+        if (this->ConversionItems == 0)
+        {
+            return;
+        }
+
+        unsigned int percent = 100 * ++this->ConvertedItems / this->ConversionItems;
+        if (std::this_thread::get_id() == this->ConversionThread && percent > this->ConversionPercent)
+        {
+            this->ConversionPercent = percent;
+            // conversion is reported as the last 10%, after the parsing
+            double progress = 0.9 + 0.001 * percent;
+            this->Parent->InvokeEvent(vtkCommand::ProgressEvent, &progress);
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Run a functor on [0, count) using at most Parent->NumberOfThreads threads.
+     * Each index is processed independently so the result does not depend on the
+     * number of threads. Warnings of the tasks are emitted afterwards, in index order.
+     * Remaining indices are skipped once an abort is requested.
+     */
+    template<typename Functor>
+    void ParallelFor(unsigned int count, Functor&& functor)
+    {
+        std::vector<std::vector<std::string>> warnings(count);
+        auto task = [&](unsigned int i)
+        {
+            if (this->AbortRequested)
+            {
+                return;
+            }
+            TaskWarnings() = &warnings[i];
+            functor(i);
+            TaskWarnings() = nullptr;
+            this->AdvanceConversion();
+        };
+
+        auto loop = [&]()
+        {
+            vtkSMPTools::For(0, static_cast<vtkIdType>(count),
+                [&](vtkIdType begin, vtkIdType end)
+                {
+                    for (vtkIdType i = begin; i < end; i++)
+                    {
+                        task(static_cast<unsigned int>(i));
+                    }
+                });
+        };
+
+        int nbThreads = this->Parent->GetNumberOfThreads();
+        if (nbThreads == 1)
+        {
+            for (unsigned int i = 0; i < count; i++)
+            {
+                task(i);
+            }
+        }
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 2, 0)
+        else if (nbThreads > 1)
+        {
+            vtkSMPTools::LocalScope(vtkSMPTools::Config{ nbThreads }, loop);
+        }
+#endif
+        else
+        {
+            loop();
+        }
+
+        for (const std::vector<std::string>& taskWarnings : warnings)
+        {
+            for (const std::string& message : taskWarnings)
+            {
+                vtkWarningWithObjectMacro(this->Parent, << message);
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Decimate large meshes into Parent->NumberOfLODs levels of detail.
+     * Skinned and morphed meshes are left alone as decimation would interpolate
+     * their joint indices and targets.
+     */
+    void GenerateLODs()
+    {
+        // Below this number of triangles, decimating costs more than it saves
+        constexpr vtkIdType minimumTriangles = 10000;
+
+        int nbLevels = this->Parent->GetNumberOfLODs();
+        this->MeshLODs.clear();
+        this->MeshLODs.resize(this->Meshes.size());
+        if (nbLevels == 0)
+        {
+            return;
+        }
+
+        vtkNew<vtkTimerLog> timer;
+        timer->StartTimer();
+
+        std::atomic<unsigned int> nbDecimated = 0;
+        this->ParallelFor(static_cast<unsigned int>(this->Meshes.size()),
+            [&](unsigned int i)
+            {
+                vtkPolyData* mesh = this->Meshes[i];
+                const aiMesh* aMesh = this->Scene->mMeshes[i];
+                if (aMesh->HasBones() || aMesh->mNumAnimMeshes > 0 ||
+                    mesh->GetPolys()->GetNumberOfCells() < minimumTriangles ||
+                    mesh->GetNumberOfCells() != mesh->GetPolys()->GetNumberOfCells())
+                {
+                    return;
+                }
+
+                for (int level = 1; level <= nbLevels; level++)
+                {
+                    vtkNew<vtkQuadricDecimation> decimation;
+                    decimation->SetInputData(mesh);
+                    decimation->SetTargetReduction(1.0 - std::pow(0.25, level));
+                    decimation->VolumePreservationOn();
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 1, 0)
+                    decimation->MapPointDataOn();
+#endif
+                    decimation->Update();
+
+                    vtkSmartPointer<vtkPolyData> lod = vtkSmartPointer<vtkPolyData>::New();
+                    lod->ShallowCopy(decimation->GetOutput());
+                    this->MeshLODs[i].emplace_back(lod);
+                }
+                nbDecimated++;
+            });
+
+        timer->StopTimer();
+
+        this->Description += "Levels of detail: ";
+        this->Description += std::to_string(nbDecimated);
+        this->Description += " meshes decimated into ";
+        this->Description += std::to_string(nbLevels);
+        this->Description += " levels in ";
+        this->Description += std::to_string(timer->GetElapsedTime());
+        this->Description += " s\n";
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Convert meshes, embedded textures and materials of the parsed scene.
+     * Every stage is parallelized over its items, results are stored by index.
+     * Returns false if the conversion was aborted.
+     */
+    bool ConvertScene()
+    {
+        vtkNew<vtkTimerLog> timer;
+        timer->StartTimer();
+
+        bool cachedMeshes = this->CachedScene != nullptr;
+        this->ConversionThread = std::this_thread::get_id();
+        this->ConversionItems = this->Scene->mNumTextures + this->Scene->mNumMaterials +
+            (cachedMeshes ? 0 : this->Scene->mNumMeshes) +
+            (this->Parent->GetNumberOfLODs() > 0 ? this->Scene->mNumMeshes : 0);
+        this->ConvertedItems = 0;
+        this->ConversionPercent = 0;
+
+        // convert meshes to polyData, or read them from the cache
+        if (!cachedMeshes)
+        {
+            this->Meshes.resize(this->Scene->mNumMeshes);
+            this->ParallelFor(this->Scene->mNumMeshes,
+                [&](unsigned int i) { this->Meshes[i] = this->CreateMesh(this->Scene->mMeshes[i]); });
+            if (this->AbortRequested)
+            {
+                return false;
+            }
+            this->WriteCachedScene();
+        }
+        this->GenerateLODs();
+
+        // read embedded textures
+        this->EmbeddedTextures.resize(this->Scene->mNumTextures);
+        this->ParallelFor(this->Scene->mNumTextures, [&](unsigned int i)
+            { this->EmbeddedTextures[i] = this->CreateEmbeddedTexture(this->Scene->mTextures[i]); });
+        if (this->AbortRequested)
+        {
+            return false;
+        }
+
+        // the image reader factory lazily builds its list of readers,
+        // make sure it is done before creating textures from several threads
+        vtkNew<vtkImageReader2Collection> registeredReaders;
+        vtkImageReader2Factory::GetRegisteredReaders(registeredReaders);
+
+        // convert materials to properties
+        this->Properties.resize(this->Scene->mNumMaterials);
+        this->ParallelFor(this->Scene->mNumMaterials,
+            [&](unsigned int i) { this->Properties[i] = this->CreateMaterial(this->Scene->mMaterials[i]); });
+        if (this->AbortRequested)
+        {
+            return false;
+        }
+
+        timer->StopTimer();
+
+        int nbThreads = this->Parent->GetNumberOfThreads();
+        if (nbThreads == 0)
+        {
+            nbThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+        }
+
+        this->Description += "Conversion time: ";
+        this->Description += std::to_string(timer->GetElapsedTime());
+        this->Description += " s (";
+        this->Description += std::to_string(nbThreads);
+        this->Description += " threads, ";
+        this->Description += std::to_string(this->Scene->mNumMeshes);
+        this->Description += " meshes, ";
+        this->Description += std::to_string(this->Scene->mNumTextures);
+        this->Description += " embedded textures, ";
+        this->Description += std::to_string(this->Scene->mNumMaterials);
+        this->Description += " materials)\n";
+        return true;
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Get the Assimp post processing steps applied when reading the file
+     */
+    unsigned int GetPostProcessFlags() const
+    {
+        return aiProcess_LimitBoneWeights
+            | aiProcess_Triangulate // b
+            | aiProcess_PopulateArmatureData // b
+            | aiProcess_ValidateDataStructure
+            | this->Parent->GetPostProcessSteps();
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Apply the post processing steps one by one, in the order Assimp applies them
+     * when they are requested together, and report the time and the vertex, face
+     * and mesh counts of each step in the description.
+     */
+    const aiScene* PostProcessScene(unsigned int flags)
+    {
+        static const std::pair<aiPostProcessSteps, const char*> orderedSteps[] = {
+            { aiProcess_ValidateDataStructure, "ValidateDataStructure" },
+            { aiProcess_RemoveRedundantMaterials, "RemoveRedundantMaterials" },
+            { aiProcess_FindInstances, "FindInstances" },
+            { aiProcess_OptimizeMeshes, "OptimizeMeshes" },
+            { aiProcess_PopulateArmatureData, "PopulateArmatureData" },
+            { aiProcess_Triangulate, "Triangulate" },
+            { aiProcess_JoinIdenticalVertices, "JoinIdenticalVertices" },
+            { aiProcess_LimitBoneWeights, "LimitBoneWeights" },
+            { aiProcess_ImproveCacheLocality, "ImproveCacheLocality" },
+        };
+
+        struct Counts
+        {
+            size_t Vertices = 0;
+            size_t Faces = 0;
+            unsigned int Meshes = 0;
+        };
+        auto count = [](const aiScene* scene)
+        {
+            Counts counts;
+            counts.Meshes = scene->mNumMeshes;
+            for (unsigned int i = 0; i < scene->mNumMeshes; i++)
+            {
+                counts.Vertices += scene->mMeshes[i]->mNumVertices;
+                counts.Faces += scene->mMeshes[i]->mNumFaces;
+            }
+            return counts;
+        };
+
+        // other steps are applied together, after the known ones
+        unsigned int otherSteps = flags;
+        for (const auto& orderedStep : orderedSteps)
+        {
+            otherSteps &= ~static_cast<unsigned int>(orderedStep.first);
+        }
+
+        const aiScene* scene = this->Importer->GetScene();
+        for (size_t i = 0; i <= std::size(orderedSteps); i++)
+        {
+            bool isOther = i == std::size(orderedSteps);
+            unsigned int step = isOther ? otherSteps : static_cast<unsigned int>(orderedSteps[i].first);
+            const char* name = isOther ? "other steps" : orderedSteps[i].second;
+
+            if (!scene || this->AbortRequested)
+            {
+                return nullptr;
+            }
+            if ((flags & step) == 0)
+            {
+                continue;
             }
 
-            // read embedded textures
-            this->EmbeddedTextures.resize(this->Scene->mNumTextures);
-            for (unsigned int i = 0; i < this->Scene->mNumTextures; i++)
+            Counts before = count(scene);
+            vtkNew<vtkTimerLog> timer;
+            timer->StartTimer();
+            scene = this->Importer->ApplyPostProcessing(step);
+            timer->StopTimer();
+            if (!scene)
             {
-                this->EmbeddedTextures[i] = this->CreateEmbeddedTexture(this->Scene->mTextures[i]);
+                return nullptr;
             }
+            Counts after = count(scene);
+
+            this->Description += "Post-process ";
+            this->Description += name;
+            this->Description += ": ";
+            this->Description += std::to_string(timer->GetElapsedTime());
+            this->Description += " s, vertices ";
+            this->Description += std::to_string(before.Vertices);
+            this->Description += " -> ";
+            this->Description += std::to_string(after.Vertices);
+            this->Description += ", faces ";
+            this->Description += std::to_string(before.Faces);
+            this->Description += " -> ";
+            this->Description += std::to_string(after.Faces);
+            this->Description += ", meshes ";
+            this->Description += std::to_string(before.Meshes);
+            this->Description += " -> ";
+            this->Description += std::to_string(after.Meshes);
+            this->Description += "\n";
+        }
+        return scene;
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Get the value identifying the settings used to create the cached scenes.
+     * Scenes depend on the Assimp version, on the post processing steps and on the
+     * arrays created by CreateMesh, identified by MeshLayout.
+     */
+    std::uint64_t GetSceneCacheStamp() const
+    {
+        // increment when CreateMesh adds or changes arrays
+        constexpr std::uint64_t MeshLayout = 3; // content hash key
+
+        return ((static_cast<std::uint64_t>(aiGetVersionRevision()) << 32) |
+                   this->GetPostProcessFlags()) ^
+            (MeshLayout * 0x9E3779B97F4A7C15ull);
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Read the scene and its meshes from the cache if it is enabled and up to date.
+     * Returns true if the scene has been read, the file is not parsed by Assimp then.
+     */
+    bool ReadCachedScene(const std::string& filePath)
+    {
+        this->SceneCacheFile.clear();
+        this->CachedScene = nullptr;
+        const std::string& cachePath = this->Parent->GetCachePath();
+        if (cachePath.empty())
+        {
+            return false;
+        }
+
+        vtkNew<vtkTimerLog> timer;
+        timer->StartTimer();
+
+        std::string directory = (std::filesystem::path(cachePath) / "scenes").string();
+        if (!F3DMeshCache::GetKey(directory, filePath, this->GetSceneCacheStamp(), this->SceneCacheKey))
+        {
+            return false;
+        }
+        this->SceneCacheFile = F3DMeshCache::GetCacheFile(directory, this->SceneCacheKey);
+
+        std::vector<vtkSmartPointer<vtkPolyData>> meshes;
+        std::unique_ptr<aiScene> scene =
+            F3DMeshCache::Read(this->SceneCacheFile, this->SceneCacheKey, meshes);
+        if (!scene)
+        {
+            return false;
+        }
+        this->CachedScene = std::move(scene);
+        this->Scene = this->CachedScene.get();
+        this->Meshes = std::move(meshes);
+
+        timer->StopTimer();
+        this->Description += "Scene cache: mapped ";
+        this->Description += std::to_string(this->Meshes.size());
+        this->Description += " meshes in ";
+        this->Description += std::to_string(timer->GetElapsedTime());
+        this->Description += " s\n";
+        return true;
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Store the scene and its converted meshes in the cache file found by ReadCachedScene.
+     * The file is written in the background, then the least recently used scenes above
+     * the cache budget are removed.
+     */
+    void WriteCachedScene()
+    {
+        if (this->SceneCacheFile.empty())
+        {
+            return;
+        }
+
+        F3DMeshCache::WriteInBackground(this->SceneCacheFile, this->SceneCacheKey, this->Scene,
+            this->Meshes, static_cast<std::uint64_t>(this->Parent->GetCacheBudget()));
+
+        this->Description += "Scene cache: writing ";
+        this->Description += this->SceneCacheFile;
+        this->Description += " in the background\n";
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Read the scene file
+     */
+    bool ReadScene(const std::string& filePath)
+    {
+        if (this->Scene)
+        {
+            // already read by Preload
+            return true;
+        }
+
+        if (this->ReadCachedScene(filePath))
+        {
+            // meshes are read from the cache, they never wrap Assimp buffers
+            this->ResetBufferOwner(false);
+        }
+        else
+        {
+            // created before the meshes are converted in parallel
+            this->ResetBufferOwner(this->CanAdoptBuffers());
 
-            // convert materials to properties
-            this->Properties.resize(this->Scene->mNumMaterials);
-            for (unsigned int i = 0; i < this->Scene->mNumMaterials; i++)
+            try
+            {
+                // the importer owns the handler
+                this->Importer->SetProgressHandler(
+                    new vtkF3DAssimpProgressHandler(this->Parent, this->AbortRequested));
+
+                // Work around for https://github.com/assimp/assimp/issues/4620
+                this->Importer->SetPropertyBool(AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS, false);
+                // steps are applied separately to be instrumented
+                this->Scene = this->Importer->ReadFile(filePath, 0);
+                if (this->Scene)
+                {
+                    this->Scene = this->PostProcessScene(this->GetPostProcessFlags());
+                }
+            }
+            catch (const DeadlyImportError& e)
             {
-                this->Properties[i] = this->CreateMaterial(this->Scene->mMaterials[i]);
+                vtkErrorWithObjectMacro(this->Parent, "Assimp exception: " << e.what());
+                return false;
             }
+        }
+
+        bool converted = !this->AbortRequested && this->Scene && this->ConvertScene();
+        this->ConversionItems = 0;
+        if (this->AbortRequested || (this->Scene && !converted))
+        {
+            this->Scene = nullptr;
+            this->CachedScene = nullptr;
+            vtkWarningWithObjectMacro(this->Parent, "Import aborted: " << filePath);
+            return false;
+        }
+        else if (this->Scene)
+        {
+            double progress = 1.0;
+            this->Parent->InvokeEvent(vtkCommand::ProgressEvent, &progress);
             return true;
         }
         else
         {
             vtkErrorWithObjectMacro(this->Parent, "Assimp failed to load: " << filePath);
 
-            auto errorDescription = this->Importer.GetErrorString();
+            auto errorDescription = this->Importer->GetErrorString();
             vtkErrorWithObjectMacro(this->Parent, "Assimp error: " << errorDescription);
             return false;
         }
@@ -789,39 +1819,57 @@ public:
 
     //----------------------------------------------------------------------------
     /**
-     * Build recursively the node tree
+     * Build recursively the node table, parents are always stored before their children
      */
-    void ImportNode(vtkRenderer* renderer, const aiNode* node, vtkMatrix4x4* parentMat, int level = 0)
+    void ImportNode(vtkRenderer* renderer, const aiNode* node, int parentIndex, int level = 0)
     {
-        vtkNew<vtkMatrix4x4> mat;
-        vtkNew<vtkMatrix4x4> localMat;
-
-        this->ConvertMatrix(node->mTransformation, localMat);
-
-        vtkMatrix4x4::Multiply4x4(parentMat, localMat, mat);
-
-        vtkNew<vtkActorCollection> actors;
+        int nodeIndex = static_cast<int>(this->Nodes.size());
+        this->Nodes.emplace_back();
+
+        Node& current = this->Nodes.back();
+        current.AssimpNode = node;
+        current.Parent = parentIndex;
+        this->ConvertMatrix(node->mTransformation, current.LocalMatrix);
+        current.LocalMTime = current.LocalMatrix->GetMTime();
+        current.Animated = (parentIndex >= 0 && this->Nodes[parentIndex].Animated) ||
+            this->AnimatedNodeNames.count(node->mName.data) > 0;
+        if (parentIndex < 0)
+        {
+            current.GlobalMatrix->DeepCopy(current.LocalMatrix);
+        }
+        else
+        {
+            vtkMatrix4x4::Multiply4x4(
+                this->Nodes[parentIndex].GlobalMatrix, current.LocalMatrix, current.GlobalMatrix);
+        }
+        std::copy(current.GlobalMatrix->GetData(), current.GlobalMatrix->GetData() + 16, current.Global);
 
         vtkIdType nPoints = 0;
         vtkIdType nCells = 0;
 
         for (unsigned int i = 0; i < node->mNumMeshes; i++)
         {
-            vtkNew<vtkActor> actor;
-            vtkNew<vtkPolyDataMapper> mapper;
-            mapper->SetInputData(this->Meshes[node->mMeshes[i]]);
-            mapper->SetColorModeToDirectScalars();
-
-            actor->SetMapper(mapper);
-            actor->SetUserMatrix(mat);
-            actor->SetProperty(this->Properties[this->Scene->mMeshes[node->mMeshes[i]]->mMaterialIndex]);
-
-            vtkPolyData* surface = vtkPolyDataMapper::SafeDownCast(actor->GetMapper())->GetInput();
+            unsigned int meshIndex = node->mMeshes[i];
+            vtkPolyData* surface = this->Meshes[meshIndex];
             nPoints += surface->GetNumberOfPoints();
             nCells += surface->GetNumberOfCells();
 
+            if (this->Parent->GetBatchStaticMeshes() && !current.Animated &&
+                this->IsBatchable(meshIndex))
+            {
+                this->BatchedMeshes.emplace_back(nodeIndex, meshIndex);
+                continue;
+            }
+
+            vtkNew<vtkActor> actor;
+            actor->SetMapper(this->GetMeshMapper(meshIndex));
+            this->SetLODMappers(actor, meshIndex);
+            actor->SetUserMatrix(current.GlobalMatrix);
+            actor->SetProperty(this->Properties[this->Scene->mMeshes[meshIndex]->mMaterialIndex]);
+            this->AddMorphedActor(actor, nodeIndex, meshIndex);
+
             renderer->AddActor(actor);
-            actors->AddItem(actor);
+            current.Actors.emplace_back(actor);
         }
 
         for (int i = 0; i < level; i++)
@@ -841,176 +1889,1654 @@ public:
             this->Description += "\n";
         }
 
-        this->NodeActors.insert({ node->mName.data, actors });
-        this->NodeLocalMatrix.insert({ node->mName.data, localMat });
-        this->NodeGlobalMatrix.insert({ node->mName.data, mat });
+        // first node wins when names are duplicated, as the previous name based lookup did
+        this->NodeIndices.insert({ node->mName.data, nodeIndex });
 
         for (unsigned int i = 0; i < node->mNumChildren; i++)
         {
-            this->ImportNode(renderer, node->mChildren[i], mat, level + 1);
+            this->ImportNode(renderer, node->mChildren[i], nodeIndex, level + 1);
         }
     }
 
     //----------------------------------------------------------------------------
     /**
-     * Build the node tree from the root
+     * Check if a mesh can be merged with others when its node is static.
+     * Skinned and morphed meshes are deformed per actor and cannot.
      */
-    void ImportRoot(vtkRenderer* renderer)
+    bool IsBatchable(unsigned int meshIndex) const
     {
-        if (this->Scene)
-        {
-            vtkNew<vtkMatrix4x4> identity;
-            this->Description += "Scene Graph:\n------------\n";
-            this->ImportNode(renderer, this->Scene->mRootNode, identity);
-
-            // even if there is no animation, the bones needs to be updated
-            this->UpdateBones();
-        }
+        const aiMesh* mesh = this->Scene->mMeshes[meshIndex];
+        return !mesh->HasBones() && mesh->mNumAnimMeshes == 0;
     }
 
     //----------------------------------------------------------------------------
     /**
-     * Update the actors matrix from the computed transformations
+     * Copy a mesh with its points, normals and tangents transformed by a node global matrix,
+     * and tag its cells with the node index in the "NodeId" cell data array
      */
-    void UpdateNodeTransform(const aiNode* node, const vtkMatrix4x4* parentMat)
+    static vtkSmartPointer<vtkPolyData> TransformMesh(
+        vtkPolyData* mesh, vtkMatrix4x4* matrix, int nodeIndex)
     {
-        vtkSmartPointer<vtkMatrix4x4> localMat = this->NodeLocalMatrix[node->mName.data];
+        vtkNew<vtkTransform> transform;
+        transform->SetMatrix(matrix);
 
-        vtkNew<vtkMatrix4x4> mat;
-        vtkMatrix4x4::Multiply4x4(parentMat, localMat, mat);
+        vtkSmartPointer<vtkPolyData> piece = vtkSmartPointer<vtkPolyData>::New();
+        piece->CopyStructure(mesh);
+        piece->GetPointData()->ShallowCopy(mesh->GetPointData());
 
-        this->NodeGlobalMatrix[node->mName.data] = mat;
+        vtkNew<vtkPoints> points;
+        points->SetDataType(mesh->GetPoints()->GetDataType());
+        transform->TransformPoints(mesh->GetPoints(), points);
+        piece->SetPoints(points);
 
-        // update current node actors
-        vtkActorCollection* actors = this->NodeActors[node->mName.data];
-        actors->InitTraversal();
+        auto transformArray = [&](vtkDataArray* in, bool normal)
+        {
+            vtkSmartPointer<vtkDataArray> out = vtkSmartPointer<vtkDataArray>::Take(in->NewInstance());
+            out->SetName(in->GetName());
+            out->SetNumberOfComponents(3);
+            if (normal)
+            {
+                transform->TransformNormals(in, out);
+            }
+            else
+            {
+                transform->TransformVectors(in, out);
+            }
+            return out;
+        };
 
-        vtkActor* actor = nullptr;
-        while ((actor = actors->GetNextActor()) != nullptr)
+        vtkPointData* pointData = piece->GetPointData();
+        if (pointData->GetNormals())
         {
-            actor->SetUserMatrix(mat);
+            pointData->SetNormals(transformArray(pointData->GetNormals(), true));
         }
-
-        for (unsigned int i = 0; i < node->mNumChildren; i++)
+        if (pointData->GetTangents())
         {
-            this->UpdateNodeTransform(node->mChildren[i], mat);
+            pointData->SetTangents(transformArray(pointData->GetTangents(), false));
         }
+
+        vtkNew<vtkIdTypeArray> nodeIds;
+        nodeIds->SetName("NodeId");
+        nodeIds->SetNumberOfTuples(piece->GetNumberOfCells());
+        nodeIds->FillValue(nodeIndex);
+        piece->GetCellData()->AddArray(nodeIds);
+
+        return piece;
     }
 
-    void UpdateCameras()
+    //----------------------------------------------------------------------------
+    /**
+     * Merge the meshes of static nodes collected by ImportNode into one actor per material.
+     * Meshes are also grouped by their point data arrays, as vtkAppendPolyData only keeps
+     * the arrays common to all its inputs.
+     */
+    void BuildBatches(vtkRenderer* renderer)
     {
-        for (auto& cam : this->Cameras)
+        if (this->BatchedMeshes.empty())
         {
-            vtkMatrix4x4* mat = this->NodeGlobalMatrix[cam.first];
-            vtkNew<vtkTransform> transform;
-            transform->SetMatrix(mat);
+            return;
+        }
 
-            // Copy non transformed camera into transformed camera
-            cam.second.second->DeepCopy(cam.second.first);
+        std::map<std::pair<unsigned int, std::string>, std::vector<std::pair<int, unsigned int>>>
+            groups;
+        for (const auto& [nodeIndex, meshIndex] : this->BatchedMeshes)
+        {
+            vtkPointData* pointData = this->Meshes[meshIndex]->GetPointData();
+            std::string signature;
+            for (int i = 0; i < pointData->GetNumberOfArrays(); i++)
+            {
+                vtkDataArray* array = pointData->GetArray(i);
+                if (array)
+                {
+                    signature += array->GetName() ? array->GetName() : "";
+                    signature += ":" + std::to_string(array->GetNumberOfComponents()) + ";";
+                }
+            }
+            groups[{ this->Scene->mMeshes[meshIndex]->mMaterialIndex, signature }].emplace_back(
+                nodeIndex, meshIndex);
+        }
 
-            // Transform the camera
-            cam.second.second->ApplyTransform(transform);
+        for (const auto& [key, members] : groups)
+        {
+            vtkNew<vtkAppendPolyData> append;
+            for (const auto& [nodeIndex, meshIndex] : members)
+            {
+                append->AddInputData(this->TransformMesh(
+                    this->Meshes[meshIndex], this->Nodes[nodeIndex].GlobalMatrix, nodeIndex));
+            }
+            append->Update();
+
+            vtkNew<vtkPolyDataMapper> mapper;
+            mapper->SetInputData(append->GetOutput());
+            mapper->SetColorModeToDirectScalars();
+            this->NumberOfMappers++;
+            this->MapperMemory += this->EstimateGPUMemory(append->GetOutput());
+
+            vtkNew<vtkActor> actor;
+            actor->SetMapper(mapper);
+            actor->SetProperty(this->Properties[key.first]);
+
+            renderer->AddActor(actor);
+            this->BatchedActors.emplace_back(actor);
         }
+
+        this->Description += "Static batching: ";
+        this->Description += std::to_string(this->BatchedMeshes.size());
+        this->Description += " meshes merged into ";
+        this->Description += std::to_string(this->BatchedActors.size());
+        this->Description += " actors\n";
     }
 
     //----------------------------------------------------------------------------
     /**
-     * Update lights position
+     * Get the mapper rendering the mesh at the given index.
+     * Nodes referencing the same mesh share its mapper, and therefore its GPU buffers,
+     * only their actors and transforms differ.
+     * Skinned meshes are not shared: their joint palette is specific to each actor
+     * and may be stored in a buffer owned by the mapper.
      */
-    void UpdateLights()
+    vtkPolyDataMapper* GetMeshMapper(unsigned int meshIndex)
     {
-        for (auto& light : this->Lights)
+        vtkPolyData* mesh = this->Meshes[meshIndex];
+        bool skinned = mesh->GetFieldData()->GetAbstractArray("Bones") != nullptr;
+
+        this->MeshMappers.resize(this->Meshes.size());
+        vtkSmartPointer<vtkPolyDataMapper>& shared = this->MeshMappers[meshIndex];
+        if (shared && !skinned)
         {
-            light.second->SetTransformMatrix(this->NodeGlobalMatrix[light.first]);
+            return shared;
         }
+
+        vtkNew<vtkPolyDataMapper> mapper;
+        mapper->SetInputData(mesh);
+        mapper->SetColorModeToDirectScalars();
+        this->NumberOfMappers++;
+        this->MapperMemory += this->EstimateGPUMemory(mesh);
+        if (!skinned)
+        {
+            shared = mapper;
+        }
+        return mapper;
     }
 
     //----------------------------------------------------------------------------
     /**
-     * Update bones information for skinning
+     * Provide the levels of detail of a mesh to the actor rendering it.
+     * Like full detail mappers, their mappers are shared by all the actors of the mesh.
      */
-    void UpdateBones()
+    void SetLODMappers(vtkActor* actor, unsigned int meshIndex)
     {
-        for (auto& pairsActor : NodeActors)
+        const std::vector<vtkSmartPointer<vtkPolyData>>& lods = this->MeshLODs[meshIndex];
+        if (lods.empty())
         {
-            vtkActorCollection* actors = pairsActor.second;
-            actors->InitTraversal();
+            return;
+        }
 
-            vtkActor* actor = nullptr;
-            while ((actor = actors->GetNextActor()) != nullptr)
+        this->MeshLODMappers.resize(this->Meshes.size());
+        std::vector<vtkSmartPointer<vtkPolyDataMapper>>& mappers = this->MeshLODMappers[meshIndex];
+        if (mappers.empty())
+        {
+            for (vtkPolyData* lod : lods)
             {
-                vtkPolyDataMapper* mapper = vtkPolyDataMapper::SafeDownCast(actor->GetMapper());
-
-                if (mapper)
-                {
-                    vtkPolyData* polyData = mapper->GetInput();
-
-                    if (polyData)
-                    {
-                        vtkStringArray* bonesList =
-                            vtkStringArray::SafeDownCast(polyData->GetFieldData()->GetAbstractArray("Bones"));
-                        vtkDoubleArray* bonesTransform = vtkDoubleArray::SafeDownCast(
-                            polyData->GetFieldData()->GetArray("InverseBindMatrices"));
-                        if (bonesList && bonesTransform)
-                        {
-                            vtkIdType nbBones = bonesList->GetNumberOfValues();
-
-                            if (nbBones > 0)
-                            {
-                                std::vector<float> vec;
-                                vec.reserve(16 * nbBones);
-
-                                vtkNew<vtkMatrix4x4> inverseRoot;
-                                actor->GetUserMatrix()->DeepCopy(inverseRoot);
-                                inverseRoot->Invert();
-
-                                for (vtkIdType i = 0; i < nbBones; i++)
-                                {
-                                    std::string boneName = bonesList->GetValue(i);
-
-                                    vtkNew<vtkMatrix4x4> boneMat;
-                                    bonesTransform->GetTypedTuple(i, boneMat->GetData());
-
-                                    auto globalMatrix = this->NodeGlobalMatrix[boneName];
-
-                                    if (globalMatrix)
-                                    {
-                                        vtkMatrix4x4::Multiply4x4(globalMatrix, boneMat, boneMat);
-                                    }
-                                    else
-                                    {
-                                        vtkWarningWithObjectMacro(
-                                            this->Parent, "Cannot find global matrix of bone " << boneName);
-                                    }
-
-                                    vtkMatrix4x4::Multiply4x4(inverseRoot, boneMat, boneMat);
-
-                                    for (int j = 0; j < 4; j++)
-                                    {
-                                        for (int k = 0; k < 4; k++)
-                                        {
-                                            vec.push_back(static_cast<float>(boneMat->GetElement(k, j)));
-                                        }
-                                    }
-                                }
-
-                                vtkShaderProperty* shaderProp = actor->GetShaderProperty();
-                                vtkUniforms* uniforms = shaderProp->GetVertexCustomUniforms();
-                                uniforms->RemoveAllUniforms();
-                                uniforms->SetUniformMatrix4x4v(
-                                    "jointMatrices", static_cast<int>(nbBones), vec.data());
-                            }
-                        }
-                    }
-                }
+                vtkNew<vtkPolyDataMapper> mapper;
+                mapper->SetInputData(lod);
+                mapper->SetColorModeToDirectScalars();
+                mappers.emplace_back(mapper);
             }
         }
+
+        vtkNew<vtkInformation> keys;
+        if (actor->GetPropertyKeys())
+        {
+            keys->Copy(actor->GetPropertyKeys());
+        }
+        vtkF3DImporter::ACTOR_LOD_MAPPERS()->Append(keys, actor->GetMapper());
+        for (vtkPolyDataMapper* mapper : mappers)
+        {
+            vtkF3DImporter::ACTOR_LOD_MAPPERS()->Append(keys, mapper);
+        }
+        actor->SetPropertyKeys(keys);
     }
 
-    Assimp::Importer Importer;
-    const aiScene* Scene = nullptr;
-    std::string Description;
+    //----------------------------------------------------------------------------
+    /**
+     * Estimate the size in bytes of the buffers uploaded to render a mesh:
+     * points and point data as floats, and the cell connectivity as 32 bits indices
+     */
+    static vtkIdType EstimateGPUMemory(vtkPolyData* mesh)
+    {
+        vtkIdType nbComponents = 3;
+        vtkPointData* pointData = mesh->GetPointData();
+        for (int i = 0; i < pointData->GetNumberOfArrays(); i++)
+        {
+            // only the morph targets bound to the mapper slots are uploaded
+            vtkDataArray* array = pointData->GetArray(i);
+            if (array && !IsMorphTargetArray(array->GetName()))
+            {
+                nbComponents += array->GetNumberOfComponents();
+            }
+        }
+
+        vtkIdType nbIndices = mesh->GetVerts()->GetNumberOfConnectivityIds() +
+            mesh->GetLines()->GetNumberOfConnectivityIds() +
+            mesh->GetPolys()->GetNumberOfConnectivityIds() +
+            mesh->GetStrips()->GetNumberOfConnectivityIds();
+
+        return 4 * (nbComponents * mesh->GetNumberOfPoints() + nbIndices);
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Report the number of draw calls and the GPU memory used by the meshes,
+     * compared to what would be used without sharing mappers between nodes
+     */
+    void DescribeRenderingCost()
+    {
+        vtkIdType nbActors = static_cast<vtkIdType>(this->BatchedActors.size());
+        vtkIdType unsharedMemory = 0;
+        for (const auto& [nodeIndex, meshIndex] : this->BatchedMeshes)
+        {
+            unsharedMemory += this->EstimateGPUMemory(this->Meshes[meshIndex]);
+        }
+        for (const Node& node : this->Nodes)
+        {
+            for (vtkActor* actor : node.Actors)
+            {
+                nbActors++;
+                unsharedMemory += this->EstimateGPUMemory(
+                    vtkPolyDataMapper::SafeDownCast(actor->GetMapper())->GetInput());
+            }
+        }
+
+        if (nbActors == 0)
+        {
+            return;
+        }
+
+        this->Description += "Draw calls: ";
+        this->Description += std::to_string(nbActors);
+        this->Description += " actors, ";
+        this->Description += std::to_string(this->NumberOfMappers);
+        this->Description += " mappers\n";
+        this->Description += "Estimated GPU memory: ";
+        this->Description += std::to_string(this->MapperMemory >> 10);
+        this->Description += " KiB (";
+        this->Description += std::to_string(unsharedMemory >> 10);
+        this->Description += " KiB without instancing and batching)\n";
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Get the index of the node with the given name, -1 if not found.
+     * Only meant to be used at import time, frame updates use resolved indices.
+     */
+    int FindNode(const std::string& name) const
+    {
+        auto it = this->NodeIndices.find(name);
+        return it != this->NodeIndices.end() ? it->second : -1;
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Copy what is needed after import from the Assimp scene: the node hierarchy,
+     * the bones and the animation keys. Must be called after the node table is built.
+     */
+    void BuildSceneGraph()
+    {
+        auto graph = std::make_shared<vtkF3DAssimpImporter::SceneGraph>();
+
+        graph->Nodes.resize(this->Nodes.size());
+        for (size_t i = 0; i < this->Nodes.size(); i++)
+        {
+            const aiNode* aNode = this->Nodes[i].AssimpNode;
+            vtkF3DAssimpImporter::SceneGraph::Node& node = graph->Nodes[i];
+            node.Name = aNode->mName.C_Str();
+            node.Parent = this->Nodes[i].Parent;
+            node.NumberOfMeshes = aNode->mNumMeshes;
+            if (node.Parent >= 0)
+            {
+                graph->Nodes[node.Parent].Children.emplace_back(static_cast<int>(i));
+            }
+        }
+
+        for (unsigned int i = 0; i < this->Scene->mNumMeshes; i++)
+        {
+            const aiMesh* aMesh = this->Scene->mMeshes[i];
+            for (unsigned int j = 0; j < aMesh->mNumBones; j++)
+            {
+                const aiBone* aBone = aMesh->mBones[j];
+                vtkF3DAssimpImporter::SceneGraph::Bone bone;
+                bone.Name = aBone->mName.C_Str();
+                bone.Node = this->FindNode(bone.Name);
+                bone.Mesh = i;
+                bone.NumberOfWeights = aBone->mNumWeights;
+                for (int k = 0; k < 16; k++)
+                {
+                    bone.OffsetMatrix[k] = aBone->mOffsetMatrix[k / 4][k % 4];
+                }
+                if (bone.Node >= 0)
+                {
+                    graph->NodeBones[bone.Node].emplace_back(static_cast<int>(graph->Bones.size()));
+                }
+                graph->Bones.emplace_back(std::move(bone));
+            }
+        }
+        for (auto& nodeBones : graph->NodeBones)
+        {
+            std::stable_sort(nodeBones.second.begin(), nodeBones.second.end(),
+                [&](int a, int b)
+                { return graph->Bones[a].NumberOfWeights > graph->Bones[b].NumberOfWeights; });
+        }
+
+        graph->Animations.resize(this->Scene->mNumAnimations);
+        for (unsigned int i = 0; i < this->Scene->mNumAnimations; i++)
+        {
+            const aiAnimation* anim = this->Scene->mAnimations[i];
+            vtkF3DAssimpImporter::SceneGraph::Animation& animation = graph->Animations[i];
+            animation.Name = anim->mName.C_Str();
+            animation.Duration = anim->mDuration;
+            animation.TicksPerSecond = anim->mTicksPerSecond;
+            animation.Channels.resize(anim->mNumChannels);
+            for (unsigned int j = 0; j < anim->mNumChannels; j++)
+            {
+                const aiNodeAnim* nodeAnim = anim->mChannels[j];
+                vtkF3DAssimpImporter::SceneGraph::Channel& channel = animation.Channels[j];
+                channel.NodeName = nodeAnim->mNodeName.C_Str();
+                channel.PositionKeys.assign(
+                    nodeAnim->mPositionKeys, nodeAnim->mPositionKeys + nodeAnim->mNumPositionKeys);
+                channel.RotationKeys.assign(
+                    nodeAnim->mRotationKeys, nodeAnim->mRotationKeys + nodeAnim->mNumRotationKeys);
+                channel.ScalingKeys.assign(
+                    nodeAnim->mScalingKeys, nodeAnim->mScalingKeys + nodeAnim->mNumScalingKeys);
+            }
+
+            animation.MorphChannels.resize(anim->mNumMorphMeshChannels);
+            for (unsigned int j = 0; j < anim->mNumMorphMeshChannels; j++)
+            {
+                const aiMeshMorphAnim* morphAnim = anim->mMorphMeshChannels[j];
+                vtkF3DAssimpImporter::SceneGraph::MorphChannel& channel = animation.MorphChannels[j];
+                channel.NodeName = morphAnim->mName.C_Str();
+                channel.Keys.resize(morphAnim->mNumKeys);
+                for (unsigned int k = 0; k < morphAnim->mNumKeys; k++)
+                {
+                    const aiMeshMorphKey& aKey = morphAnim->mKeys[k];
+                    channel.Keys[k].Time = aKey.mTime;
+                    channel.Keys[k].Targets.assign(
+                        aKey.mValues, aKey.mValues + aKey.mNumValuesAndWeights);
+                    channel.Keys[k].Weights.assign(
+                        aKey.mWeights, aKey.mWeights + aKey.mNumValuesAndWeights);
+                }
+            }
+        }
+
+        this->Graph = graph;
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Release the Assimp scene once everything has been converted.
+     * It is kept when some arrays wrap its buffers, they own the importer in that case.
+     */
+    void ReleaseScene()
+    {
+        if (!this->Scene || this->BufferOwner)
+        {
+            return;
+        }
+
+        for (Node& node : this->Nodes)
+        {
+            node.AssimpNode = nullptr;
+        }
+        if (this->CachedScene)
+        {
+            this->CachedScene = nullptr;
+        }
+        else
+        {
+            this->Importer->FreeScene();
+        }
+        this->Scene = nullptr;
+        this->Description += "Assimp scene released after import\n";
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Resolve the nodes animated by each channel of each animation
+     */
+    void ResolveAnimationChannels()
+    {
+        const auto& animations = this->Graph->Animations;
+        this->ChannelNodes.resize(animations.size());
+        for (size_t i = 0; i < animations.size(); i++)
+        {
+            this->ChannelNodes[i].resize(animations[i].Channels.size());
+            for (size_t j = 0; j < animations[i].Channels.size(); j++)
+            {
+                this->ChannelNodes[i][j] = this->FindNode(animations[i].Channels[j].NodeName);
+            }
+        }
+
+        this->MorphChannelNodes.resize(animations.size());
+        for (size_t i = 0; i < animations.size(); i++)
+        {
+            this->MorphChannelNodes[i].resize(animations[i].MorphChannels.size());
+            for (size_t j = 0; j < animations[i].MorphChannels.size(); j++)
+            {
+                this->MorphChannelNodes[i][j] =
+                    this->FindNode(animations[i].MorphChannels[j].NodeName);
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Convert a row major double matrix to a column major float matrix,
+     * the layout expected by the jointMatrices uniform
+     */
+    static void ToColumnMajor(const double* in, float* out)
+    {
+        for (int j = 0; j < 4; j++)
+        {
+            for (int k = 0; k < 4; k++)
+            {
+                out[4 * j + k] = static_cast<float>(in[4 * k + j]);
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Multiply two column major float matrices, c = a * b.
+     * c must not alias a or b.
+     */
+    static void MultiplyColumnMajor(const float* a, const float* b, float* c)
+    {
+#ifdef F3D_ASSIMP_USE_SSE
+        __m128 a0 = _mm_loadu_ps(a);
+        __m128 a1 = _mm_loadu_ps(a + 4);
+        __m128 a2 = _mm_loadu_ps(a + 8);
+        __m128 a3 = _mm_loadu_ps(a + 12);
+        for (int j = 0; j < 4; j++)
+        {
+            const float* bj = b + 4 * j;
+            __m128 r = _mm_mul_ps(a0, _mm_set1_ps(bj[0]));
+            r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(bj[1])));
+            r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(bj[2])));
+            r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(bj[3])));
+            _mm_storeu_ps(c + 4 * j, r);
+        }
+#else
+        for (int j = 0; j < 4; j++)
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                c[4 * j + i] = a[i] * b[4 * j] + a[4 + i] * b[4 * j + 1] +
+                    a[8 + i] * b[4 * j + 2] + a[12 + i] * b[4 * j + 3];
+            }
+        }
+#endif
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Compute the bind pose bounds of the points influenced by each bone of a skinned mesh.
+     * A skinned point is a weighted average of its positions transformed by its bones,
+     * so it always lies in the union of these bounds transformed by the joint matrices.
+     */
+    static std::vector<vtkBoundingBox> ComputeBoneBounds(vtkPolyData* polyData, vtkIdType nbBones)
+    {
+        std::vector<vtkBoundingBox> bounds(nbBones);
+        vtkDataArray* joints = polyData->GetPointData()->GetArray("JOINTS_0");
+        vtkDataArray* weights = polyData->GetPointData()->GetArray("WEIGHTS_0");
+        if (!joints || !weights)
+        {
+            return bounds;
+        }
+
+        for (vtkIdType i = 0; i < polyData->GetNumberOfPoints(); i++)
+        {
+            double point[3];
+            polyData->GetPoint(i, point);
+            for (int j = 0; j < 4; j++)
+            {
+                vtkIdType bone = static_cast<vtkIdType>(joints->GetComponent(i, j));
+                if (weights->GetComponent(i, j) > 0 && bone < nbBones)
+                {
+                    bounds[bone].AddPoint(point);
+                }
+            }
+        }
+        return bounds;
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Set the bounds of the actors of a skeleton deformed by its current palette,
+     * used by the renderer for culling as skinning is performed on the GPU
+     */
+    static void UpdateSkinnedBounds(const std::vector<vtkSmartPointer<vtkActor>>& actors,
+        const std::vector<std::vector<vtkBoundingBox>>& actorsBoneBounds,
+        const std::vector<float>& palette)
+    {
+        for (size_t a = 0; a < actors.size(); a++)
+        {
+            vtkBoundingBox skinned;
+            const std::vector<vtkBoundingBox>& boneBounds = actorsBoneBounds[a];
+            for (size_t i = 0; i < boneBounds.size(); i++)
+            {
+                if (!boneBounds[i].IsValid())
+                {
+                    continue;
+                }
+
+                const float* joint = palette.data() + 16 * i;
+                for (int c = 0; c < 8; c++)
+                {
+                    double corner[3];
+                    boneBounds[i].GetCorner(c, corner);
+                    double transformed[3];
+                    for (int k = 0; k < 3; k++)
+                    {
+                        transformed[k] = joint[k] * corner[0] + joint[4 + k] * corner[1] +
+                            joint[8 + k] * corner[2] + joint[12 + k];
+                    }
+                    skinned.AddPoint(transformed);
+                }
+            }
+
+            if (!skinned.IsValid())
+            {
+                continue;
+            }
+
+            vtkActor* actor = actors[a];
+            if (!actor->GetPropertyKeys())
+            {
+                vtkNew<vtkInformation> keys;
+                actor->SetPropertyKeys(keys);
+            }
+            double bounds[6];
+            skinned.GetBounds(bounds);
+            actor->GetPropertyKeys()->Set(vtkF3DImporter::ACTOR_SKINNED_BOUNDS(), bounds, 6);
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Group skinned actors by skeleton and resolve the bone nodes of each skeleton.
+     * Actors share a skeleton when they belong to the same node and use the same
+     * bones with the same inverse bind matrices, their joint palette is then identical.
+     */
+    void ResolveSkeletons()
+    {
+        for (int nodeIndex = 0; nodeIndex < static_cast<int>(this->Nodes.size()); nodeIndex++)
+        {
+            for (vtkActor* actor : this->Nodes[nodeIndex].Actors)
+            {
+                vtkPolyDataMapper* mapper = vtkPolyDataMapper::SafeDownCast(actor->GetMapper());
+                vtkPolyData* polyData = mapper ? mapper->GetInput() : nullptr;
+                if (!polyData)
+                {
+                    continue;
+                }
+
+                vtkStringArray* bonesList =
+                    vtkStringArray::SafeDownCast(polyData->GetFieldData()->GetAbstractArray("Bones"));
+                vtkDoubleArray* bonesTransform = vtkDoubleArray::SafeDownCast(
+                    polyData->GetFieldData()->GetArray("InverseBindMatrices"));
+                if (!bonesList || !bonesTransform || bonesList->GetNumberOfValues() == 0)
+                {
+                    continue;
+                }
+
+                vtkIdType nbBones = bonesList->GetNumberOfValues();
+                Skeleton skeleton;
+                skeleton.RootNode = nodeIndex;
+                skeleton.BoneNodes.resize(nbBones);
+                skeleton.InverseBindMatrices.resize(16 * nbBones);
+                for (vtkIdType i = 0; i < nbBones; i++)
+                {
+                    const std::string& boneName = bonesList->GetValue(i);
+                    skeleton.BoneNodes[i] = this->FindNode(boneName);
+                    if (skeleton.BoneNodes[i] < 0)
+                    {
+                        vtkWarningWithObjectMacro(
+                            this->Parent, "Cannot find global matrix of bone " << boneName);
+                    }
+
+                    double ibm[16];
+                    bonesTransform->GetTypedTuple(i, ibm);
+                    ToColumnMajor(ibm, skeleton.InverseBindMatrices.data() + 16 * i);
+                }
+
+                auto existing = std::find_if(this->Skeletons.begin(), this->Skeletons.end(),
+                    [&](const Skeleton& other)
+                    {
+                        return other.RootNode == skeleton.RootNode &&
+                            other.BoneNodes == skeleton.BoneNodes &&
+                            other.InverseBindMatrices == skeleton.InverseBindMatrices;
+                    });
+                if (existing == this->Skeletons.end())
+                {
+                    skeleton.Palette.resize(16 * nbBones);
+                    existing = this->Skeletons.insert(existing, std::move(skeleton));
+                }
+                existing->Actors.emplace_back(actor);
+                existing->BoneBounds.emplace_back(ComputeBoneBounds(polyData, nbBones));
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Build the node tree from the root
+     */
+    void ImportRoot(vtkRenderer* renderer)
+    {
+        if (this->Scene)
+        {
+            if (this->Parent->GetBatchStaticMeshes())
+            {
+                for (unsigned int i = 0; i < this->Scene->mNumAnimations; i++)
+                {
+                    const aiAnimation* anim = this->Scene->mAnimations[i];
+                    for (unsigned int j = 0; j < anim->mNumChannels; j++)
+                    {
+                        this->AnimatedNodeNames.insert(anim->mChannels[j]->mNodeName.data);
+                    }
+                }
+            }
+
+            this->Description += "Scene Graph:\n------------\n";
+            this->ImportNode(renderer, this->Scene->mRootNode, -1);
+            this->BuildSceneGraph();
+            this->BuildBatches(renderer);
+            this->DescribeRenderingCost();
+
+            this->ResolveAnimationChannels();
+            this->ResolveSkeletons();
+
+            // even if there is no animation, the bones needs to be updated
+            this->EvaluateBones();
+            this->CommitPose();
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Get the time of a key, in ticks
+     */
+    template<typename KeyType>
+    static double KeyTime(const KeyType& key)
+    {
+        return key.mTime;
+    }
+
+    static double KeyTime(const vtkF3DAssimpImporter::SceneGraph::MorphKey& key)
+    {
+        return key.Time;
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Get the index of the first key not before tick, like std::lower_bound.
+     * cursor is the index found by the previous call on the same keys: during playback
+     * the answer is almost always the same key or the next one, so these are checked
+     * first and the binary search only happens on seeks.
+     */
+    template<typename KeyType>
+    static unsigned int FindKey(const KeyType* keys, unsigned int nbKeys, double tick, unsigned int& cursor)
+    {
+        auto isAt = [&](unsigned int index)
+        {
+            return (index == 0 || KeyTime(keys[index - 1]) < tick) &&
+                (index == nbKeys || KeyTime(keys[index]) >= tick);
+        };
+
+        if (cursor <= nbKeys && isAt(cursor))
+        {
+            return cursor;
+        }
+        if (cursor < nbKeys && isAt(cursor + 1))
+        {
+            return ++cursor;
+        }
+
+        const KeyType* key = std::lower_bound(keys, keys + nbKeys, tick,
+            [](const KeyType& k, const double& time) { return KeyTime(k) < time; });
+        cursor = static_cast<unsigned int>(key - keys);
+        return cursor;
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Interpolate the keys at tick, def is returned if there is no key
+     */
+    template<typename KeyType, typename ValueType>
+    static ValueType SampleKeys(const KeyType* keys, unsigned int nbKeys, double tick,
+        unsigned int& cursor, const ValueType& def)
+    {
+        if (nbKeys == 0)
+        {
+            return def;
+        }
+
+        unsigned int index = FindKey(keys, nbKeys, tick, cursor);
+        if (index == 0)
+        {
+            return keys[0].mValue;
+        }
+        if (index == nbKeys)
+        {
+            return keys[nbKeys - 1].mValue;
+        }
+
+        const KeyType& prev = keys[index - 1];
+        const KeyType& next = keys[index];
+        ai_real d = static_cast<ai_real>((tick - prev.mTime) / (next.mTime - prev.mTime));
+
+        ValueType value;
+        Assimp::Interpolator<KeyType>()(value, prev, next, d);
+        return value;
+    }
+
+    template<typename KeyType, typename ValueType>
+    static ValueType SampleKeys(
+        const std::vector<KeyType>& keys, double tick, unsigned int& cursor, const ValueType& def)
+    {
+        return SampleKeys(
+            keys.data(), static_cast<unsigned int>(keys.size()), tick, cursor, def);
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Set a local matrix from a translation, a rotation quaternion (w, x, y, z) and a scaling
+     */
+    static void ComposeLocalMatrix(
+        vtkMatrix4x4* transform, const double translation[3], const double quaternion[4], const double scaling[3])
+    {
+        vtkQuaternion<double> rotation(quaternion);
+        rotation.Normalize();
+
+        double rotationMatrix[3][3];
+        rotation.ToMatrix3x3(rotationMatrix);
+
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                transform->SetElement(i, j, scaling[j] * rotationMatrix[i][j]);
+            }
+            transform->SetElement(i, 3, translation[i]);
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Resample all the channels of the active animation at Parent->AnimationBakingRate.
+     * Does nothing if baking is disabled, already done or over the memory budget.
+     */
+    void BakeAnimation()
+    {
+        double rate = this->Parent->GetAnimationBakingRate();
+        if (this->ActiveAnimation < 0 || rate <= 0.0 ||
+            (this->Baked.Animation == this->ActiveAnimation && this->Baked.Rate == rate))
+        {
+            return;
+        }
+        this->Baked = BakedAnimation();
+
+        const vtkF3DAssimpImporter::SceneGraph::Animation& anim =
+            this->Graph->Animations[this->ActiveAnimation];
+        double fps = anim.TicksPerSecond != 0.0 ? anim.TicksPerSecond : 1.0;
+        size_t nbSamples = static_cast<size_t>(std::ceil(anim.Duration / fps * rate)) + 1;
+        size_t nbChannels = anim.Channels.size();
+        size_t nbValues = nbSamples * nbChannels;
+
+        vtkIdType memory = static_cast<vtkIdType>(nbValues * sizeof(float) * BakedAnimation::NbComponents);
+        if (memory > this->Parent->GetAnimationBakingBudget())
+        {
+            this->Description += "Animation \"";
+            this->Description += anim.Name;
+            this->Description += "\" not baked: ";
+            this->Description += std::to_string(memory >> 20);
+            this->Description += " MiB needed, keys are interpolated instead\n";
+            return;
+        }
+
+        for (std::vector<float>& component : this->Baked.Components)
+        {
+            component.resize(nbValues);
+        }
+
+        // channels are independent, each one keeps its own cursors while walking forward in time
+        this->ParallelFor(static_cast<unsigned int>(nbChannels),
+            [&](unsigned int c)
+            {
+                const vtkF3DAssimpImporter::SceneGraph::Channel& channel = anim.Channels[c];
+                ChannelCursor cursor;
+                aiQuaternion previous;
+                for (size_t sample = 0; sample < nbSamples; sample++)
+                {
+                    double tick = std::min(sample / rate * fps, anim.Duration);
+
+                    aiVector3D translation =
+                        SampleKeys(channel.PositionKeys, tick, cursor.Position, aiVector3D(0, 0, 0));
+                    aiQuaternion quaternion =
+                        SampleKeys(channel.RotationKeys, tick, cursor.Rotation, aiQuaternion());
+                    aiVector3D scaling =
+                        SampleKeys(channel.ScalingKeys, tick, cursor.Scaling, aiVector3D(1, 1, 1));
+
+                    // keep consecutive samples in the same hemisphere so they can be
+                    // blended without checking the sign when evaluating
+                    if (sample > 0 &&
+                        quaternion.w * previous.w + quaternion.x * previous.x +
+                            quaternion.y * previous.y + quaternion.z * previous.z < 0)
+                    {
+                        quaternion = aiQuaternion(-quaternion.w, -quaternion.x, -quaternion.y, -quaternion.z);
+                    }
+                    previous = quaternion;
+
+                    float values[BakedAnimation::NbComponents] = { static_cast<float>(translation.x),
+                        static_cast<float>(translation.y), static_cast<float>(translation.z),
+                        static_cast<float>(quaternion.w), static_cast<float>(quaternion.x),
+                        static_cast<float>(quaternion.y), static_cast<float>(quaternion.z),
+                        static_cast<float>(scaling.x), static_cast<float>(scaling.y),
+                        static_cast<float>(scaling.z) };
+
+                    size_t index = sample * nbChannels + c;
+                    for (int k = 0; k < BakedAnimation::NbComponents; k++)
+                    {
+                        this->Baked.Components[k][index] = values[k];
+                    }
+                }
+            });
+
+        this->Baked.Animation = this->ActiveAnimation;
+        this->Baked.Rate = rate;
+        this->Baked.NumberOfSamples = nbSamples;
+        this->Baked.NumberOfChannels = nbChannels;
+
+        this->Description += "Animation \"";
+        this->Description += anim.Name;
+        this->Description += "\" baked: ";
+        this->Description += std::to_string(nbSamples);
+        this->Description += " samples, ";
+        this->Description += std::to_string(nbChannels);
+        this->Description += " channels, ";
+        this->Description += std::to_string(memory >> 10);
+        this->Description += " KiB\n";
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Update the local matrices of the animated nodes from the baked samples.
+     * Returns false if the active animation is not baked.
+     */
+    bool EvaluateBakedAnimation(double timeValue)
+    {
+        const BakedAnimation& baked = this->Baked;
+        if (baked.Animation < 0 || baked.Animation != this->ActiveAnimation)
+        {
+            return false;
+        }
+
+        double position = std::max(timeValue * baked.Rate, 0.0);
+        size_t first = std::min(static_cast<size_t>(position), baked.NumberOfSamples - 1);
+        size_t second = std::min(first + 1, baked.NumberOfSamples - 1);
+        float alpha = static_cast<float>(std::min(position - first, 1.0));
+        float beta = 1.0f - alpha;
+
+        // blend all channels at once, component by component, in contiguous buffers
+        size_t nbChannels = baked.NumberOfChannels;
+        this->BakedFrame.resize(nbChannels * BakedAnimation::NbComponents);
+        for (int k = 0; k < BakedAnimation::NbComponents; k++)
+        {
+            const float* a = baked.Components[k].data() + first * nbChannels;
+            const float* b = baked.Components[k].data() + second * nbChannels;
+            float* out = this->BakedFrame.data() + k * nbChannels;
+            for (size_t c = 0; c < nbChannels; c++)
+            {
+                out[c] = beta * a[c] + alpha * b[c];
+            }
+        }
+
+        const std::vector<int>& channelNodes = this->ChannelNodes[baked.Animation];
+        for (size_t c = 0; c < nbChannels; c++)
+        {
+            int nodeIndex = channelNodes[c];
+            if (nodeIndex >= 0)
+            {
+                const float* frame = this->BakedFrame.data() + c;
+                double translation[3] = { frame[0], frame[nbChannels], frame[2 * nbChannels] };
+                double quaternion[4] = { frame[3 * nbChannels], frame[4 * nbChannels],
+                    frame[5 * nbChannels], frame[6 * nbChannels] };
+                double scaling[3] = { frame[7 * nbChannels], frame[8 * nbChannels],
+                    frame[9 * nbChannels] };
+                ComposeLocalMatrix(this->Nodes[nodeIndex].LocalMatrix, translation, quaternion, scaling);
+            }
+        }
+
+        return true;
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Update the evaluated global matrices from the local ones in a single pass over the
+     * node table. Only the subtrees below a local matrix that changed since the last pass
+     * are recomputed, GlobalChanged is set on the nodes that were.
+     * The global matrices used by the actors are only modified by CommitPose.
+     */
+    void UpdateNodeTransforms()
+    {
+        this->NumberOfUpdatedNodes = 0;
+        for (Node& node : this->Nodes)
+        {
+            vtkMTimeType localMTime = node.LocalMatrix->GetMTime();
+            node.GlobalChanged = localMTime != node.LocalMTime ||
+                (node.Parent >= 0 && this->Nodes[node.Parent].GlobalChanged);
+            if (!node.GlobalChanged)
+            {
+                continue;
+            }
+            node.LocalMTime = localMTime;
+            node.CommitPending = true;
+            this->NumberOfUpdatedNodes++;
+
+            const double* local = node.LocalMatrix->GetData();
+            if (node.Parent < 0)
+            {
+                std::copy(local, local + 16, node.Global);
+            }
+            else
+            {
+                vtkMatrix4x4::Multiply4x4(this->Nodes[node.Parent].Global, local, node.Global);
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Get the key of a time value in the pose cache, its index on the PoseCacheTimeStep grid
+     */
+    long long GetPoseKey(double timeValue) const
+    {
+        return std::llround(timeValue / this->Parent->GetPoseCacheTimeStep());
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Check if the evaluated poses are stored and restored, only while seeking
+     */
+    bool IsPoseCacheUsed() const
+    {
+        return this->Parent->GetPoseCacheSize() > 0 && this->Parent->GetSeeking();
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Copy the cached pose of a time value as the evaluated pose, marking what changed
+     * as pending a commit. Returns false if the pose is not cached.
+     */
+    bool RestorePose(double timeValue)
+    {
+        if (!this->IsPoseCacheUsed())
+        {
+            return false;
+        }
+        auto found = this->PoseCacheIndex.find(this->GetPoseKey(timeValue));
+        if (found == this->PoseCacheIndex.end())
+        {
+            return false;
+        }
+        this->PoseCache.splice(this->PoseCache.begin(), this->PoseCache, found->second);
+        const CachedPose& pose = *found->second;
+
+        this->NumberOfUpdatedNodes = 0;
+        const double* global = pose.Globals.data();
+        for (Node& node : this->Nodes)
+        {
+            if (!std::equal(global, global + 16, node.Global))
+            {
+                std::copy(global, global + 16, node.Global);
+                node.CommitPending = true;
+                this->NumberOfUpdatedNodes++;
+            }
+            global += 16;
+
+            // local matrices are not restored, the next evaluation recomputes all nodes
+            node.LocalMTime = 0;
+        }
+
+        const float* palette = pose.Palettes.data();
+        for (Skeleton& skeleton : this->Skeletons)
+        {
+            size_t size = skeleton.Palette.size();
+            if (!std::equal(palette, palette + size, skeleton.Palette.data()))
+            {
+                std::copy(palette, palette + size, skeleton.Palette.data());
+                skeleton.CommitPending = true;
+            }
+            palette += size;
+        }
+
+        const float* weights = pose.MorphWeights.data();
+        for (MorphedActor& morphed : this->MorphedActors)
+        {
+            std::copy(weights, weights + morphed.Weights.size(), morphed.Weights.data());
+            weights += morphed.Weights.size();
+        }
+        return true;
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Store the evaluated pose of a time value in the cache,
+     * discarding the least recently used poses if it is full
+     */
+    void StorePose(double timeValue)
+    {
+        int capacity = this->Parent->GetPoseCacheSize();
+        long long key = this->GetPoseKey(timeValue);
+        if (!this->IsPoseCacheUsed() || this->PoseCacheIndex.count(key))
+        {
+            return;
+        }
+
+        // reuse the buffers of the evicted pose
+        CachedPose pose;
+        while (this->PoseCache.size() >= static_cast<size_t>(capacity))
+        {
+            pose = std::move(this->PoseCache.back());
+            this->PoseCacheIndex.erase(pose.Key);
+            this->PoseCache.pop_back();
+        }
+        pose.Key = key;
+
+        pose.Globals.resize(16 * this->Nodes.size());
+        double* global = pose.Globals.data();
+        for (const Node& node : this->Nodes)
+        {
+            global = std::copy(node.Global, node.Global + 16, global);
+        }
+
+        pose.Palettes.clear();
+        for (const Skeleton& skeleton : this->Skeletons)
+        {
+            pose.Palettes.insert(pose.Palettes.end(), skeleton.Palette.begin(), skeleton.Palette.end());
+        }
+
+        pose.MorphWeights.clear();
+        for (const MorphedActor& morphed : this->MorphedActors)
+        {
+            pose.MorphWeights.insert(
+                pose.MorphWeights.end(), morphed.Weights.begin(), morphed.Weights.end());
+        }
+
+        this->PoseCache.emplace_front(std::move(pose));
+        this->PoseCacheIndex[key] = this->PoseCache.begin();
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Discard all cached poses, when the active animation changes
+     */
+    void ClearPoseCache()
+    {
+        this->PoseCache.clear();
+        this->PoseCacheIndex.clear();
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Apply the last evaluated pose to what the renderer uses: the global matrices,
+     * which are the actors user matrices, the joint palettes and morph weights uniforms,
+     * the cameras and the lights.
+     * Evaluation and commit must not run concurrently, but evaluation can run on
+     * another thread while rendering.
+     */
+    void CommitPose()
+    {
+        for (Node& node : this->Nodes)
+        {
+            if (node.CommitPending)
+            {
+                node.GlobalMatrix->DeepCopy(node.Global);
+            }
+        }
+
+        this->UpdateMorphSlots();
+        for (MorphedActor& morphed : this->MorphedActors)
+        {
+            this->UploadMorphWeights(morphed, false);
+        }
+
+        for (Skeleton& skeleton : this->Skeletons)
+        {
+            if (skeleton.CommitPending)
+            {
+                for (vtkActor* actor : skeleton.Actors)
+                {
+                    actor->GetShaderProperty()->GetVertexCustomUniforms()->SetUniformMatrix4x4v(
+                        "jointMatrices", static_cast<int>(skeleton.BoneNodes.size()),
+                        skeleton.Palette.data());
+                }
+                UpdateSkinnedBounds(skeleton.Actors, skeleton.BoneBounds, skeleton.Palette);
+                skeleton.Uploaded = true;
+                skeleton.CommitPending = false;
+            }
+        }
+
+        this->UpdateCameras();
+        this->UpdateLights();
+
+        for (Node& node : this->Nodes)
+        {
+            node.CommitPending = false;
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Return true if the global matrix of the node changed during the last update
+     */
+    bool HasGlobalChanged(int nodeIndex) const
+    {
+        return nodeIndex >= 0 && this->Nodes[nodeIndex].GlobalChanged;
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Return true if the global matrix of the node changed since the last commit
+     */
+    bool HasCommitPending(int nodeIndex) const
+    {
+        return nodeIndex >= 0 && this->Nodes[nodeIndex].CommitPending;
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Update cameras position, only for the cameras whose node moved unless all is true
+     */
+    void UpdateCameras(bool all = false)
+    {
+        for (size_t i = 0; i < this->Cameras.size(); i++)
+        {
+            auto& cam = this->Cameras[i];
+            int nodeIndex = this->CameraNodes[i];
+            if (!all && !this->HasCommitPending(nodeIndex))
+            {
+                continue;
+            }
+
+            // Copy non transformed camera into transformed camera
+            cam.second.second->DeepCopy(cam.second.first);
+
+            // Transform the camera
+            if (nodeIndex >= 0)
+            {
+                vtkNew<vtkTransform> transform;
+                transform->SetMatrix(this->Nodes[nodeIndex].GlobalMatrix);
+                cam.second.second->ApplyTransform(transform);
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Update lights position, only for the lights whose node moved unless all is true
+     */
+    void UpdateLights(bool all = false)
+    {
+        for (size_t i = 0; i < this->Lights.size(); i++)
+        {
+            int nodeIndex = this->LightNodes[i];
+            if (all || this->HasCommitPending(nodeIndex))
+            {
+                this->Lights[i].second->SetTransformMatrix(
+                    nodeIndex >= 0 ? this->Nodes[nodeIndex].GlobalMatrix.Get() : nullptr);
+            }
+        }
+    }
+
+    // the mapper supports a limited number of morph targets, bound to its attribute slots
+    static constexpr int NbMorphSlots = 4;
+    using MorphSlotArray = std::array<int, NbMorphSlots>;
+
+    struct MorphedActor
+    {
+        vtkSmartPointer<vtkActor> Actor;
+        int Node = -1;
+        unsigned int Mesh = 0;
+        std::vector<float> Weights; // current weight of each target of the mesh
+        float Uploaded[NbMorphSlots] = { 0, 0, 0, 0 };
+    };
+
+    //----------------------------------------------------------------------------
+    /**
+     * Check if a point data array stores the offsets of a morph target, as created by CreateMesh
+     */
+    static bool IsMorphTargetArray(const char* name)
+    {
+        return name && std::strncmp(name, "MorphTarget", 11) == 0;
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Get the number of morph targets of a mesh
+     */
+    vtkIdType GetNumberOfMorphTargets(unsigned int meshIndex) const
+    {
+        vtkAbstractArray* names =
+            this->Meshes[meshIndex]->GetFieldData()->GetAbstractArray("MorphTargets");
+        return names ? names->GetNumberOfValues() : 0;
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Bind morph targets to the attribute slots of the mapper, -1 leaves a slot empty.
+     * Slot arrays share the memory of the target arrays, only the bound ones are uploaded.
+     * Slots already bound to the same target are left untouched.
+     */
+    void BindMorphSlots(unsigned int meshIndex, const MorphSlotArray& slots)
+    {
+        vtkPointData* pointData = this->Meshes[meshIndex]->GetPointData();
+        for (int i = 0; i < NbMorphSlots; i++)
+        {
+            if (slots[i] == this->MorphSlots[meshIndex][i])
+            {
+                continue;
+            }
+            for (const char* attribute : { "_position", "_normal" })
+            {
+                std::string slotName = "target" + std::to_string(i) + attribute;
+                vtkDataArray* target = slots[i] < 0
+                    ? nullptr
+                    : pointData->GetArray(("MorphTarget" + std::to_string(slots[i]) + attribute).c_str());
+                if (target)
+                {
+                    vtkNew<vtkFloatArray> slot;
+                    slot->ShallowCopy(target);
+                    slot->SetName(slotName.c_str());
+                    pointData->AddArray(slot);
+                }
+                else
+                {
+                    pointData->RemoveArray(slotName.c_str());
+                }
+            }
+        }
+        this->MorphSlots[meshIndex] = slots;
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Register an actor rendering a mesh with morph targets.
+     * The first targets are bound to the mapper slots and the weights are initialized
+     * with the default ones of the mesh.
+     */
+    void AddMorphedActor(vtkActor* actor, int nodeIndex, unsigned int meshIndex)
+    {
+        vtkIdType nbTargets = this->GetNumberOfMorphTargets(meshIndex);
+        if (nbTargets == 0)
+        {
+            return;
+        }
+
+        this->MorphSlots.resize(this->Meshes.size(), { -1, -1, -1, -1 });
+        if (this->MorphSlots[meshIndex][0] < 0)
+        {
+            MorphSlotArray slots;
+            for (int i = 0; i < NbMorphSlots; i++)
+            {
+                slots[i] = i < nbTargets ? i : -1;
+            }
+            this->BindMorphSlots(meshIndex, slots);
+
+            if (nbTargets > NbMorphSlots)
+            {
+                this->Description += "Mesh with ";
+                this->Description += std::to_string(nbTargets);
+                this->Description += " morph targets, only ";
+                this->Description += std::to_string(NbMorphSlots);
+                this->Description += " of them are applied at once\n";
+            }
+        }
+
+        MorphedActor morphed;
+        morphed.Actor = actor;
+        morphed.Node = nodeIndex;
+        morphed.Mesh = meshIndex;
+        morphed.Weights.resize(nbTargets);
+        vtkFloatArray* defaults = vtkFloatArray::SafeDownCast(
+            this->Meshes[meshIndex]->GetFieldData()->GetAbstractArray("MorphWeights"));
+        for (vtkIdType i = 0; defaults && i < nbTargets; i++)
+        {
+            morphed.Weights[i] = defaults->GetValue(i);
+        }
+        this->MorphedActors.emplace_back(std::move(morphed));
+
+        // the uniform must exist before the shader is built for the mapper to use the slots
+        this->UploadMorphWeights(this->MorphedActors.back(), true);
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Bind the morph targets animated by the active animation to the mapper slots.
+     * Meshes with more targets than slots start with the targets reaching the highest weights,
+     * UpdateMorphSlots then follows the current weights at each frame.
+     */
+    void AssignMorphSlots()
+    {
+        if (this->ActiveAnimation < 0 || this->MorphedActors.empty())
+        {
+            return;
+        }
+
+        const auto& channels = this->Graph->Animations[this->ActiveAnimation].MorphChannels;
+        const std::vector<int>& channelNodes = this->MorphChannelNodes[this->ActiveAnimation];
+
+        std::map<unsigned int, std::vector<double>> peaks;
+        for (const MorphedActor& morphed : this->MorphedActors)
+        {
+            std::vector<double>& peak = peaks[morphed.Mesh];
+            peak.resize(morphed.Weights.size());
+            for (size_t i = 0; i < morphed.Weights.size(); i++)
+            {
+                peak[i] = std::max(peak[i], static_cast<double>(std::abs(morphed.Weights[i])));
+            }
+
+            for (size_t c = 0; c < channels.size(); c++)
+            {
+                if (channelNodes[c] != morphed.Node)
+                {
+                    continue;
+                }
+                for (const auto& key : channels[c].Keys)
+                {
+                    for (size_t k = 0; k < key.Targets.size(); k++)
+                    {
+                        if (key.Targets[k] < peak.size())
+                        {
+                            peak[key.Targets[k]] =
+                                std::max(peak[key.Targets[k]], std::abs(key.Weights[k]));
+                        }
+                    }
+                }
+            }
+        }
+
+        for (const auto& [meshIndex, peak] : peaks)
+        {
+            if (peak.size() <= static_cast<size_t>(NbMorphSlots))
+            {
+                continue;
+            }
+
+            auto nbUsed = std::count_if(peak.begin(), peak.end(), [](double w) { return w > 0; });
+            if (nbUsed > NbMorphSlots)
+            {
+                this->Warn("Mesh " + std::to_string(meshIndex) + " uses " + std::to_string(nbUsed) +
+                    " morph targets, only the " + std::to_string(NbMorphSlots) +
+                    " with the highest weights are applied at each frame");
+            }
+
+            std::vector<int> order(peak.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(
+                order.begin(), order.end(), [&](int a, int b) { return peak[a] > peak[b]; });
+
+            MorphSlotArray slots;
+            std::copy(order.begin(), order.begin() + NbMorphSlots, slots.begin());
+            std::sort(slots.begin(), slots.end());
+            if (slots != this->MorphSlots[meshIndex])
+            {
+                this->BindMorphSlots(meshIndex, slots);
+            }
+        }
+
+        for (MorphedActor& morphed : this->MorphedActors)
+        {
+            this->UploadMorphWeights(morphed, true);
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Bind the targets with the highest current weights to the mapper slots, for meshes having
+     * more targets than slots. The weight of a target is its highest one among the actors of
+     * the mesh. Rebinding uploads the mesh again, so a bound target is kept in its slot
+     * until another target gets a strictly higher weight.
+     */
+    void UpdateMorphSlots()
+    {
+        std::map<unsigned int, std::vector<float>> meshWeights;
+        for (const MorphedActor& morphed : this->MorphedActors)
+        {
+            if (morphed.Weights.size() <= static_cast<size_t>(NbMorphSlots))
+            {
+                continue;
+            }
+            std::vector<float>& weights = meshWeights[morphed.Mesh];
+            weights.resize(morphed.Weights.size());
+            for (size_t i = 0; i < weights.size(); i++)
+            {
+                weights[i] = std::max(weights[i], std::abs(morphed.Weights[i]));
+            }
+        }
+
+        for (const auto& [meshIndex, weights] : meshWeights)
+        {
+            const MorphSlotArray& bound = this->MorphSlots[meshIndex];
+            auto isBound = [&](int target)
+            { return std::find(bound.begin(), bound.end(), target) != bound.end(); };
+
+            std::vector<int> order(weights.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::partial_sort(order.begin(), order.begin() + NbMorphSlots, order.end(),
+                [&](int a, int b)
+                {
+                    if (weights[a] != weights[b])
+                    {
+                        return weights[a] > weights[b];
+                    }
+                    bool aBound = isBound(a);
+                    return aBound != isBound(b) ? aBound : a < b;
+                });
+            auto selectedEnd = order.begin() + NbMorphSlots;
+
+            // targets still selected stay in their slot, new ones take the freed slots
+            MorphSlotArray slots = bound;
+            for (int& slot : slots)
+            {
+                if (std::find(order.begin(), selectedEnd, slot) == selectedEnd)
+                {
+                    slot = -1;
+                }
+            }
+            for (auto it = order.begin(); it != selectedEnd; ++it)
+            {
+                if (std::find(slots.begin(), slots.end(), *it) == slots.end())
+                {
+                    *std::find(slots.begin(), slots.end(), -1) = *it;
+                }
+            }
+
+            if (slots != bound)
+            {
+                this->BindMorphSlots(meshIndex, slots);
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Evaluate the morph weight channels of the active animation at the given tick.
+     * Targets not listed in a key have a zero weight at that key.
+     */
+    void EvaluateMorphWeights(double tick)
+    {
+        if (this->ActiveAnimation < 0 || this->MorphedActors.empty())
+        {
+            return;
+        }
+
+        const auto& channels = this->Graph->Animations[this->ActiveAnimation].MorphChannels;
+        const std::vector<int>& channelNodes = this->MorphChannelNodes[this->ActiveAnimation];
+        this->MorphCursors.resize(channels.size());
+
+        for (size_t c = 0; c < channels.size(); c++)
+        {
+            const auto& keys = channels[c].Keys;
+            if (channelNodes[c] < 0 || keys.empty())
+            {
+                continue;
+            }
+
+            unsigned int nbKeys = static_cast<unsigned int>(keys.size());
+            unsigned int index = FindKey(keys.data(), nbKeys, tick, this->MorphCursors[c]);
+            const auto& prev = keys[index == 0 ? 0 : index - 1];
+            const auto& next = keys[std::min(index, nbKeys - 1)];
+            double d = next.Time > prev.Time ? (tick - prev.Time) / (next.Time - prev.Time) : 0.0;
+
+            for (MorphedActor& morphed : this->MorphedActors)
+            {
+                if (morphed.Node != channelNodes[c])
+                {
+                    continue;
+                }
+
+                std::fill(morphed.Weights.begin(), morphed.Weights.end(), 0.f);
+                auto accumulate = [&](const vtkF3DAssimpImporter::SceneGraph::MorphKey& key, double factor)
+                {
+                    for (size_t k = 0; k < key.Targets.size(); k++)
+                    {
+                        if (key.Targets[k] < morphed.Weights.size())
+                        {
+                            morphed.Weights[key.Targets[k]] += static_cast<float>(factor * key.Weights[k]);
+                        }
+                    }
+                };
+                accumulate(prev, 1.0 - d);
+                accumulate(next, d);
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Set the morphWeights uniform of an actor from the weights of the targets bound
+     * to the mapper slots, only if they changed unless force is true
+     */
+    void UploadMorphWeights(MorphedActor& morphed, bool force)
+    {
+        const MorphSlotArray& slots = this->MorphSlots[morphed.Mesh];
+        float weights[NbMorphSlots];
+        for (int i = 0; i < NbMorphSlots; i++)
+        {
+            weights[i] = slots[i] < 0 ? 0.f : morphed.Weights[slots[i]];
+        }
+
+        if (force || !std::equal(weights, weights + NbMorphSlots, morphed.Uploaded))
+        {
+            std::copy(weights, weights + NbMorphSlots, morphed.Uploaded);
+            morphed.Actor->GetShaderProperty()->GetVertexCustomUniforms()->SetUniform1fv(
+                "morphWeights", NbMorphSlots, weights);
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    /**
+     * Evaluate bones information for skinning.
+     * The joint palette of each skeleton is computed once, in place, from the evaluated
+     * global matrices. CommitPose only uploads it to its actors when it changed.
+     */
+    void EvaluateBones()
+    {
+        for (Skeleton& skeleton : this->Skeletons)
+        {
+            size_t nbBones = skeleton.BoneNodes.size();
+            bool moved = !skeleton.Uploaded || this->HasGlobalChanged(skeleton.RootNode) ||
+                std::any_of(skeleton.BoneNodes.begin(), skeleton.BoneNodes.end(),
+                    [&](int boneNode) { return this->HasGlobalChanged(boneNode); });
+            if (!moved)
+            {
+                continue;
+            }
+
+            // the actors user matrix is the global matrix of their node
+            double inverseRootData[16];
+            vtkMatrix4x4::Invert(this->Nodes[skeleton.RootNode].Global, inverseRootData);
+            float inverseRoot[16];
+            ToColumnMajor(inverseRootData, inverseRoot);
+
+            bool changed = !skeleton.Uploaded;
+            for (size_t i = 0; i < nbBones; i++)
+            {
+                const float* ibm = skeleton.InverseBindMatrices.data() + 16 * i;
+
+                float boneMat[16];
+                int boneNode = skeleton.BoneNodes[i];
+                if (boneNode >= 0)
+                {
+                    float global[16];
+                    ToColumnMajor(this->Nodes[boneNode].Global, global);
+                    MultiplyColumnMajor(global, ibm, boneMat);
+                }
+                else
+                {
+                    std::copy(ibm, ibm + 16, boneMat);
+                }
+
+                float joint[16];
+                MultiplyColumnMajor(inverseRoot, boneMat, joint);
+
+                float* palette = skeleton.Palette.data() + 16 * i;
+                if (!std::equal(joint, joint + 16, palette))
+                {
+                    std::copy(joint, joint + 16, palette);
+                    changed = true;
+                }
+            }
+
+            skeleton.CommitPending = skeleton.CommitPending || changed;
+        }
+    }
+
+    std::shared_ptr<Assimp::Importer> Importer = std::make_shared<Assimp::Importer>();
+    vtkSmartPointer<vtkF3DAssimpBufferOwner> BufferOwner;
+
+    struct PendingTexture
+    {
+        vtkSmartPointer<vtkTexture> Texture;
+        F3DTextureCache::ImageFuture Image;
+        std::string Path;
+    };
+    std::mutex TexturesMutex;
+    std::map<std::pair<std::string, bool>, vtkSmartPointer<vtkTexture>> FileTextures;
+    std::map<std::pair<int, bool>, vtkSmartPointer<vtkTexture>> SharedEmbeddedTextures;
+    std::vector<PendingTexture> PendingTextures;
+    size_t TextureRequests = 0;
+    size_t TextureCacheHits = 0;
+    const aiScene* Scene = nullptr; // released after import, see ReleaseScene
+    std::shared_ptr<vtkF3DAssimpImporter::SceneGraph> Graph =
+        std::make_shared<vtkF3DAssimpImporter::SceneGraph>();
+    std::atomic<bool> AbortRequested = false;
+    std::thread::id ConversionThread;
+    unsigned int ConversionItems = 0; // 0 when no conversion is in progress
+    std::atomic<unsigned int> ConvertedItems = 0;
+    unsigned int ConversionPercent = 0;
+    std::string Description;
+    std::string SceneCacheFile;
+    F3DMeshCache::Key SceneCacheKey;
+    std::unique_ptr<aiScene> CachedScene; // set when the scene has been read from the cache
     std::vector<vtkSmartPointer<vtkPolyData>> Meshes;
+    std::vector<vtkSmartPointer<vtkPolyDataMapper>> MeshMappers; // shared mapper of each mesh
+    std::vector<std::vector<vtkSmartPointer<vtkPolyData>>> MeshLODs; // decimated levels of each mesh
+    std::vector<std::vector<vtkSmartPointer<vtkPolyDataMapper>>> MeshLODMappers;
+    vtkIdType NumberOfMappers = 0;
+    vtkIdType MapperMemory = 0;
     std::vector<vtkSmartPointer<vtkProperty>> Properties;
     std::vector<vtkSmartPointer<vtkTexture>> EmbeddedTextures;
     vtkIdType ActiveAnimation = -1; // -1 means no animation enabled here
@@ -1019,10 +3545,88 @@ public:
         std::pair<std::string, std::pair<vtkSmartPointer<vtkCamera>, vtkSmartPointer<vtkCamera>>>>
         Cameras;
     vtkIdType ActiveCameraIndex = -1;
-    std::unordered_map<std::string, vtkSmartPointer<vtkActorCollection>> NodeActors;
-    std::unordered_map<std::string, vtkSmartPointer<vtkMatrix4x4>> NodeLocalMatrix;
-    std::unordered_map<std::string, vtkSmartPointer<vtkMatrix4x4>> NodeTRSMatrix;
-    std::unordered_map<std::string, vtkSmartPointer<vtkMatrix4x4>> NodeGlobalMatrix;
+    std::vector<int> CameraNodes;
+    std::vector<int> LightNodes;
+
+    struct Node
+    {
+        const aiNode* AssimpNode = nullptr; // only valid until the scene is released
+        int Parent = -1;
+        vtkSmartPointer<vtkMatrix4x4> LocalMatrix = vtkSmartPointer<vtkMatrix4x4>::New();
+        vtkSmartPointer<vtkMatrix4x4> GlobalMatrix = vtkSmartPointer<vtkMatrix4x4>::New();
+        std::vector<vtkSmartPointer<vtkActor>> Actors;
+        vtkMTimeType LocalMTime = 0;
+        bool GlobalChanged = true;
+        double Global[16]; // evaluated global matrix, copied to GlobalMatrix by CommitPose
+        bool CommitPending = false; // Global changed since the last commit
+        bool Animated = false; // the node or one of its parents is animated by a channel
+    };
+    std::vector<Node> Nodes;
+    vtkIdType NumberOfUpdatedNodes = 0;
+    std::unordered_map<std::string, int> NodeIndices;
+
+    // static meshes merged by material, only filled when BatchStaticMeshes is enabled
+    std::unordered_set<std::string> AnimatedNodeNames;
+    std::vector<std::pair<int, unsigned int>> BatchedMeshes; // node and mesh indices
+    std::vector<vtkSmartPointer<vtkActor>> BatchedActors;
+
+    // node index animated by each channel of each animation, -1 if not found
+    std::vector<std::vector<int>> ChannelNodes;
+
+    // morph targets bound to each slot of each mesh, and actors rendering these meshes
+    std::vector<MorphSlotArray> MorphSlots;
+    std::vector<MorphedActor> MorphedActors;
+    std::vector<std::vector<int>> MorphChannelNodes; // like ChannelNodes, for morph channels
+    std::vector<unsigned int> MorphCursors; // last key found for each morph channel
+
+    // last key found for each channel of the active animation
+    struct ChannelCursor
+    {
+        unsigned int Position = 0;
+        unsigned int Rotation = 0;
+        unsigned int Scaling = 0;
+    };
+    std::vector<ChannelCursor> ChannelCursors;
+
+    // samples of the baked animation, one buffer per component (translation xyz,
+    // rotation wxyz, scaling xyz), each storing all channels of a sample contiguously
+    struct BakedAnimation
+    {
+        static constexpr int NbComponents = 10;
+        vtkIdType Animation = -1;
+        double Rate = 0;
+        size_t NumberOfSamples = 0;
+        size_t NumberOfChannels = 0;
+        std::vector<float> Components[NbComponents];
+    };
+    BakedAnimation Baked;
+    std::vector<float> BakedFrame;
+
+    // matrices are column major floats, as uploaded in the jointMatrices uniform
+    struct Skeleton
+    {
+        int RootNode = -1;
+        std::vector<int> BoneNodes; // -1 if the bone node was not found
+        std::vector<float> InverseBindMatrices;
+        std::vector<float> Palette;
+        bool Uploaded = false;
+        bool CommitPending = false; // Palette changed since the last commit
+        std::vector<vtkSmartPointer<vtkActor>> Actors;
+        std::vector<std::vector<vtkBoundingBox>> BoneBounds; // for each actor, bind pose bounds per bone
+    };
+    std::vector<Skeleton> Skeletons;
+
+    // evaluated poses of the active animation, most recently used first
+    struct CachedPose
+    {
+        long long Key = 0;
+        std::vector<double> Globals; // 16 per node
+        std::vector<float> Palettes; // palettes of all skeletons
+        std::vector<float> MorphWeights; // weights of all morphed actors
+    };
+    std::list<CachedPose> PoseCache;
+    std::unordered_map<long long, std::list<CachedPose>::iterator> PoseCacheIndex;
+
     vtkF3DAssimpImporter* Parent;
 };
 
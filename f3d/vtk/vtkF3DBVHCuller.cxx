@@ -0,0 +1,335 @@
+#include "vtkF3DBVHCuller.h"
+
+#include "vtkF3DImporter.h"
+
+#include <vtkActor.h>
+#include <vtkBoundingBox.h>
+#include <vtkCamera.h>
+#include <vtkCellArray.h>
+#include <vtkInformation.h>
+#include <vtkInformationDoubleVectorKey.h>
+#include <vtkMatrix4x4.h>
+#include <vtkObjectFactory.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkProp3D.h>
+#include <vtkRenderer.h>
+
+#include <algorithm>
+
+vtkStandardNewMacro(vtkF3DBVHCuller);
+
+namespace
+{
+// Maximum number of props in a leaf node of the hierarchy
+constexpr int MAX_LEAF_SIZE = 4;
+
+// Classify a box against frustum planes: -1 outside, 0 intersecting, 1 inside.
+// Plane normals point inside the frustum.
+int ClassifyBox(const double planes[24], const double bounds[6])
+{
+  int result = 1;
+  for (int i = 0; i < 6; i++)
+  {
+    const double* p = planes + 4 * i;
+    double maxDistance = p[3];
+    double minDistance = p[3];
+    for (int j = 0; j < 3; j++)
+    {
+      double lo = p[j] * bounds[2 * j];
+      double hi = p[j] * bounds[2 * j + 1];
+      maxDistance += std::max(lo, hi);
+      minDistance += std::min(lo, hi);
+    }
+    if (maxDistance < 0)
+    {
+      return -1;
+    }
+    if (minDistance < 0)
+    {
+      result = 0;
+    }
+  }
+  return result;
+}
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DBVHCuller::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfVisibleProps: " << this->NumberOfVisibleProps << endl;
+  os << indent << "NumberOfCulledProps: " << this->NumberOfCulledProps << endl;
+  os << indent << "NumberOfVisibleTriangles: " << this->NumberOfVisibleTriangles << endl;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkF3DBVHCuller::GetNumberOfTriangles(vtkProp* prop)
+{
+  vtkActor* actor = vtkActor::SafeDownCast(prop);
+  vtkPolyDataMapper* mapper =
+    actor ? vtkPolyDataMapper::SafeDownCast(actor->GetMapper()) : nullptr;
+  vtkPolyData* polyData = mapper ? mapper->GetInput() : nullptr;
+  if (!polyData)
+  {
+    return 0;
+  }
+
+  // n - 2 triangles for each cell of n points, lines and vertices have none
+  vtkIdType triangles = 0;
+  for (vtkCellArray* cells : { polyData->GetPolys(), polyData->GetStrips() })
+  {
+    if (cells)
+    {
+      vtkIdType cellTriangles =
+        cells->GetNumberOfConnectivityIds() - 2 * cells->GetNumberOfCells();
+      triangles += std::max<vtkIdType>(0, cellTriangles);
+    }
+  }
+  return triangles;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DBVHCuller::UpdateLeaf(Leaf& leaf)
+{
+  vtkInformation* info = leaf.Prop->GetPropertyKeys();
+  vtkMTimeType stamp = leaf.Prop->GetRedrawMTime();
+  if (info)
+  {
+    stamp = std::max(stamp, info->GetMTime());
+  }
+
+  // the redraw MTime does not include the data the bounds are computed from
+  vtkActor* actor = vtkActor::SafeDownCast(leaf.Prop);
+  vtkMapper* mapper = actor ? actor->GetMapper() : nullptr;
+  if (mapper)
+  {
+    stamp = std::max(stamp, mapper->GetMTime());
+    vtkDataObject* input =
+      mapper->GetNumberOfInputPorts() > 0 ? mapper->GetInputDataObject(0, 0) : nullptr;
+    if (input)
+    {
+      stamp = std::max(stamp, input->GetMTime());
+    }
+  }
+  if (stamp == leaf.Stamp)
+  {
+    return false;
+  }
+  leaf.Stamp = stamp;
+
+  vtkProp3D* prop3D = vtkProp3D::SafeDownCast(leaf.Prop);
+  if (prop3D && info && info->Has(vtkF3DImporter::ACTOR_SKINNED_BOUNDS()))
+  {
+    // Skinned model bounds, transformed to world space
+    const double* model = info->Get(vtkF3DImporter::ACTOR_SKINNED_BOUNDS());
+    vtkMatrix4x4* matrix = prop3D->GetMatrix();
+    vtkBoundingBox box;
+    for (int i = 0; i < 8; i++)
+    {
+      double corner[4] = { model[i & 1], model[2 + ((i >> 1) & 1)], model[4 + ((i >> 2) & 1)],
+        1.0 };
+      matrix->MultiplyPoint(corner, corner);
+      box.AddPoint(corner);
+    }
+    box.GetBounds(leaf.Bounds);
+    leaf.Infinite = false;
+    return true;
+  }
+
+  const double* bounds = leaf.Prop->GetBounds();
+  leaf.Infinite = !bounds || !vtkBoundingBox::IsValid(bounds);
+  if (!leaf.Infinite)
+  {
+    std::copy(bounds, bounds + 6, leaf.Bounds);
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DBVHCuller::Build()
+{
+  this->LeafOrder.clear();
+  for (int i = 0; i < static_cast<int>(this->Leaves.size()); i++)
+  {
+    if (!this->Leaves[i].Infinite)
+    {
+      this->LeafOrder.emplace_back(i);
+    }
+  }
+
+  this->Nodes.clear();
+  if (!this->LeafOrder.empty())
+  {
+    this->BuildNode(0, static_cast<int>(this->LeafOrder.size()));
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkF3DBVHCuller::BuildNode(int first, int count)
+{
+  int index = static_cast<int>(this->Nodes.size());
+  this->Nodes.emplace_back();
+  this->Nodes[index].First = first;
+  this->Nodes[index].Count = count;
+
+  vtkBoundingBox box;
+  vtkBoundingBox centers;
+  for (int i = first; i < first + count; i++)
+  {
+    const double* bounds = this->Leaves[this->LeafOrder[i]].Bounds;
+    box.AddBounds(bounds);
+    centers.AddPoint(
+      (bounds[0] + bounds[1]) / 2.0, (bounds[2] + bounds[3]) / 2.0, (bounds[4] + bounds[5]) / 2.0);
+  }
+  box.GetBounds(this->Nodes[index].Bounds);
+
+  if (count <= MAX_LEAF_SIZE)
+  {
+    return index;
+  }
+
+  // Median split of the props along the largest extent of their centers
+  double lengths[3];
+  centers.GetLengths(lengths);
+  int axis = static_cast<int>(std::max_element(lengths, lengths + 3) - lengths);
+  auto begin = this->LeafOrder.begin() + first;
+  std::nth_element(begin, begin + count / 2, begin + count,
+    [&](int a, int b)
+    {
+      const double* ba = this->Leaves[a].Bounds;
+      const double* bb = this->Leaves[b].Bounds;
+      return ba[2 * axis] + ba[2 * axis + 1] < bb[2 * axis] + bb[2 * axis + 1];
+    });
+
+  int left = this->BuildNode(first, count / 2);
+  int right = this->BuildNode(first + count / 2, count - count / 2);
+  this->Nodes[index].Left = left;
+  this->Nodes[index].Right = right;
+  return index;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DBVHCuller::Refit()
+{
+  for (auto it = this->Nodes.rbegin(); it != this->Nodes.rend(); ++it)
+  {
+    vtkBoundingBox box;
+    if (it->Left < 0)
+    {
+      for (int i = it->First; i < it->First + it->Count; i++)
+      {
+        box.AddBounds(this->Leaves[this->LeafOrder[i]].Bounds);
+      }
+    }
+    else
+    {
+      box.AddBounds(this->Nodes[it->Left].Bounds);
+      box.AddBounds(this->Nodes[it->Right].Bounds);
+    }
+    box.GetBounds(it->Bounds);
+  }
+}
+
+//----------------------------------------------------------------------------
+double vtkF3DBVHCuller::Cull(
+  vtkRenderer* ren, vtkProp** propList, int& listLength, int& vtkNotUsed(initialized))
+{
+  // Rebuild when the props changed, otherwise only refit the moved ones
+  bool sameProps = static_cast<int>(this->Leaves.size()) == listLength;
+  for (int i = 0; sameProps && i < listLength; i++)
+  {
+    sameProps = this->Leaves[i].Prop == propList[i];
+  }
+
+  bool rebuild = !sameProps;
+  bool refit = false;
+  if (rebuild)
+  {
+    this->Leaves.assign(listLength, Leaf());
+    for (int i = 0; i < listLength; i++)
+    {
+      this->Leaves[i].Prop = propList[i];
+    }
+  }
+  for (Leaf& leaf : this->Leaves)
+  {
+    bool wasInfinite = leaf.Infinite;
+    if (this->UpdateLeaf(leaf))
+    {
+      refit = true;
+      rebuild = rebuild || wasInfinite != leaf.Infinite;
+    }
+  }
+
+  if (rebuild)
+  {
+    this->Build();
+  }
+  else if (refit)
+  {
+    this->Refit();
+  }
+
+  // Traverse the hierarchy, whole subtrees are accepted or rejected at once
+  this->Visible.assign(this->Leaves.size(), 0);
+  for (size_t i = 0; i < this->Leaves.size(); i++)
+  {
+    this->Visible[i] = this->Leaves[i].Infinite;
+  }
+
+  if (!this->Nodes.empty())
+  {
+    double planes[24];
+    ren->GetActiveCamera()->GetFrustumPlanes(ren->GetTiledAspectRatio(), planes);
+
+    std::vector<int> stack = { 0 };
+    while (!stack.empty())
+    {
+      const BVHNode& node = this->Nodes[stack.back()];
+      stack.pop_back();
+
+      int classification = ClassifyBox(planes, node.Bounds);
+      if (classification < 0)
+      {
+        continue;
+      }
+      if (classification > 0 || node.Left < 0)
+      {
+        for (int i = node.First; i < node.First + node.Count; i++)
+        {
+          int leaf = this->LeafOrder[i];
+          this->Visible[leaf] =
+            classification > 0 || ClassifyBox(planes, this->Leaves[leaf].Bounds) >= 0;
+        }
+        continue;
+      }
+      stack.emplace_back(node.Left);
+      stack.emplace_back(node.Right);
+    }
+  }
+
+  return this->CompactVisible(propList, listLength);
+}
+
+//----------------------------------------------------------------------------
+double vtkF3DBVHCuller::CompactVisible(vtkProp** propList, int& listLength)
+{
+  // Compact the list, keeping the original order
+  int kept = 0;
+  this->NumberOfVisibleTriangles = 0;
+  for (int i = 0; i < listLength; i++)
+  {
+    if (this->Visible[i])
+    {
+      propList[kept++] = propList[i];
+      this->NumberOfVisibleTriangles += vtkF3DBVHCuller::GetNumberOfTriangles(propList[i]);
+    }
+  }
+
+  this->NumberOfVisibleProps = kept;
+  this->NumberOfCulledProps = listLength - kept;
+  listLength = kept;
+
+  return static_cast<double>(kept);
+}
@@ -0,0 +1,110 @@
+/**
+ * @class   vtkF3DBVHCuller
+ * @brief   cull props outside of the view frustum using a bounding volume hierarchy
+ *
+ * Props are stored in a bounding volume hierarchy over their world bounds.
+ * The hierarchy is rebuilt when the list of props to render changes, and only refitted
+ * when the bounds of some props changed, which is detected using their redraw MTime
+ * and, for actors, the MTime of their mapper and its input.
+ * Props without valid bounds, like the skybox, are never culled.
+ *
+ * Actors having the vtkF3DImporter::ACTOR_SKINNED_BOUNDS key use these model bounds
+ * instead of their mapper bounds, as skinning is performed on the GPU.
+ */
+
+#ifndef vtkF3DBVHCuller_h
+#define vtkF3DBVHCuller_h
+
+#include <vtkCuller.h>
+
+#include <vector>
+
+class vtkF3DBVHCuller : public vtkCuller
+{
+public:
+  static vtkF3DBVHCuller* New();
+  vtkTypeMacro(vtkF3DBVHCuller, vtkCuller);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Remove the props outside of the renderer active camera frustum from the list.
+   * The order of the remaining props is preserved.
+   */
+  double Cull(vtkRenderer* ren, vtkProp** propList, int& listLength, int& initialized) override;
+
+  ///@{
+  /**
+   * Get the number of props kept and removed by the last call to Cull
+   */
+  vtkGetMacro(NumberOfVisibleProps, int);
+  vtkGetMacro(NumberOfCulledProps, int);
+  ///@}
+
+  /**
+   * Get the number of triangles of the poly data actors kept by the last call to Cull
+   */
+  vtkGetMacro(NumberOfVisibleTriangles, vtkIdType);
+
+  /**
+   * Get the number of triangles submitted by a prop, if it is an actor with a poly data input.
+   * Polygons and triangle strips of n points count as n - 2 triangles.
+   */
+  static vtkIdType GetNumberOfTriangles(vtkProp* prop);
+
+protected:
+  vtkF3DBVHCuller() = default;
+  ~vtkF3DBVHCuller() override = default;
+
+private:
+  vtkF3DBVHCuller(const vtkF3DBVHCuller&) = delete;
+  void operator=(const vtkF3DBVHCuller&) = delete;
+
+  struct Leaf
+  {
+    vtkProp* Prop = nullptr;
+    vtkMTimeType Stamp = 0;
+    double Bounds[6];
+    bool Infinite = false;
+  };
+
+  struct BVHNode
+  {
+    double Bounds[6];
+    int Left = -1; // children are stored after their parent, -1 for leaves
+    int Right = -1;
+    int First = 0; // range of LeafOrder covered by the node
+    int Count = 0;
+  };
+
+  /**
+   * Update the bounds of a leaf if its prop changed, returns true if it did
+   */
+  static bool UpdateLeaf(Leaf& leaf);
+
+  /**
+   * Build the hierarchy over the finite leaves
+   */
+  void Build();
+  int BuildNode(int first, int count);
+
+  /**
+   * Recompute the bounds of all nodes from their leaves, children first
+   */
+  void Refit();
+
+  /**
+   * Remove the props not flagged in Visible from the list and update the counts
+   */
+  double CompactVisible(vtkProp** propList, int& listLength);
+
+  std::vector<Leaf> Leaves;
+  std::vector<int> LeafOrder;
+  std::vector<BVHNode> Nodes;
+  std::vector<char> Visible;
+
+  int NumberOfVisibleProps = 0;
+  int NumberOfCulledProps = 0;
+  vtkIdType NumberOfVisibleTriangles = 0;
+};
+
+#endif
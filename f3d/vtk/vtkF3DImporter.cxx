@@ -1,8 +1,12 @@
 #include "vtkF3DImporter.h"
 
+#include <vtkInformationDoubleVectorKey.h>
 #include <vtkInformationIntegerKey.h>
+#include <vtkInformationObjectBaseVectorKey.h>
 
 vtkInformationKeyMacro(vtkF3DImporter, ACTOR_IS_ARMATURE, Integer);
+vtkInformationKeyMacro(vtkF3DImporter, ACTOR_LOD_MAPPERS, ObjectBaseVector);
+vtkInformationKeyRestrictedMacro(vtkF3DImporter, ACTOR_SKINNED_BOUNDS, DoubleVector, 6);
 
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
 
@@ -28,6 +32,26 @@ void vtkF3DImporter::UpdateTimeStep(double timeValue)
 
 #endif
 
+//----------------------------------------------------------------------------
+bool vtkF3DImporter::EvaluateAtTimeValue(double timeValue)
+{
+  this->EvaluatedTimeValue = timeValue;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DImporter::CommitEvaluatedTimeValue()
+{
+  return this->UpdateAtTimeValue(this->EvaluatedTimeValue);
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DImporter::SetSeeking(bool seeking)
+{
+  // not a modification of the importer, only a hint for the next updates
+  this->Seeking = seeking;
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DImporter::SetFailureStatus()
 {
@@ -14,7 +14,9 @@
 #include <vtkImporter.h>
 #include <vtkVersion.h>
 
+class vtkInformationDoubleVectorKey;
 class vtkInformationIntegerKey;
+class vtkInformationObjectBaseVectorKey;
 
 class /*VTKEXT_EXPORT*/ vtkF3DImporter : public vtkImporter
 {
@@ -25,6 +27,21 @@ public:
    */
   static vtkInformationIntegerKey* ACTOR_IS_ARMATURE();
 
+  /**
+   * Information key used to provide levels of detail of an actor.
+   * It stores mappers rendering the actor geometry with decreasing detail,
+   * the first one being the full detail level.
+   * The renderer switches between them based on the projected size of the actor.
+   */
+  static vtkInformationObjectBaseVectorKey* ACTOR_LOD_MAPPERS();
+
+  /**
+   * Information key used to provide the bounds of a skinned actor.
+   * It stores the model space bounds of the actor geometry once deformed
+   * by its current joint matrices, as skinning is performed on the GPU.
+   */
+  static vtkInformationDoubleVectorKey* ACTOR_SKINNED_BOUNDS();
+
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
   /**
    * This method should be reimplemented in importer
@@ -37,6 +54,35 @@ public:
   void UpdateTimeStep(double timeValue) override;
 #endif
 
+  /**
+   * Evaluate the importer at a time value without modifying anything used by the renderer,
+   * CommitEvaluatedTimeValue then applies the evaluated state.
+   * This lets the next frame be evaluated on another thread while the current one is rendered,
+   * the two methods must not be called concurrently.
+   * This default implementation only stores the time value, the whole update happening
+   * in CommitEvaluatedTimeValue.
+   * Return false on failure.
+   */
+  virtual bool EvaluateAtTimeValue(double timeValue);
+
+  /**
+   * Apply the state evaluated by the last call to EvaluateAtTimeValue.
+   * Must be called from the rendering thread. Return false on failure.
+   */
+  virtual bool CommitEvaluatedTimeValue();
+
+  ///@{
+  /**
+   * Set/Get if the next time value updates are seeks, like moving a time slider,
+   * rather than the successive frames of a playback.
+   * Importers may keep the states evaluated while seeking, as seeks often come back
+   * to times already visited, while the frames of a playback would only evict them.
+   * Default is false.
+   */
+  virtual void SetSeeking(bool seeking);
+  vtkGetMacro(Seeking, bool);
+  ///@}
+
 #if VTK_VERSION_NUMBER < VTK_VERSION_CHECK(9, 4, 20250507)
   enum class AnimationSupportLevel : unsigned char{ NONE, UNIQUE, SINGLE, MULTI };
 
@@ -55,6 +101,10 @@ public:
    * by the VTK version in use
    */
   void SetFailureStatus();
+
+protected:
+  double EvaluatedTimeValue = 0;
+  bool Seeking = false;
 };
 
 #endif
@@ -498,15 +498,60 @@ bool vtkF3DMetaImporter::GetTemporalInformation(vtkIdType animationIndex, double
 
 //----------------------------------------------------------------------------
 bool vtkF3DMetaImporter::UpdateAtTimeValue(double timeValue)
+{
+  return this->EvaluateAtTimeValue(timeValue) && this->CommitEvaluatedTimeValue();
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DMetaImporter::EvaluateAtTimeValue(double timeValue)
+{
+  this->EvaluatedTimeValue = timeValue;
+
+  bool ret = true;
+  for (const auto& importerPair : this->Pimpl->Importers)
+  {
+    vtkF3DImporter* importer = vtkF3DImporter::SafeDownCast(importerPair.Importer);
+    if (importer)
+    {
+      ret = importer->EvaluateAtTimeValue(timeValue) && ret;
+    }
+  }
+  return ret;
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DMetaImporter::SetSeeking(bool seeking)
+{
+  this->Superclass::SetSeeking(seeking);
+  for (const auto& importerPair : this->Pimpl->Importers)
+  {
+    vtkF3DImporter* importer = vtkF3DImporter::SafeDownCast(importerPair.Importer);
+    if (importer)
+    {
+      importer->SetSeeking(seeking);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkF3DMetaImporter::CommitEvaluatedTimeValue()
 {
   bool ret = true;
   for (const auto& importerPair : this->Pimpl->Importers)
   {
+    vtkF3DImporter* importer = vtkF3DImporter::SafeDownCast(importerPair.Importer);
+    if (importer)
+    {
+      ret = importer->CommitEvaluatedTimeValue() && ret;
+    }
+    else
+    {
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 3, 20240707)
-    ret = ret && importerPair.Importer->UpdateAtTimeValue(timeValue);
+      ret = ret && importerPair.Importer->UpdateAtTimeValue(this->EvaluatedTimeValue);
 #else
-    importerPair.Importer->UpdateTimeStep(timeValue);
+      importerPair.Importer->UpdateTimeStep(this->EvaluatedTimeValue);
 #endif
+    }
   }
 
   // Update coloring and point sprites
@@ -161,6 +161,20 @@ public:
    */
   bool UpdateAtTimeValue(double timeValue) override;
 
+  ///@{
+  /**
+   * Evaluate each individual importer at the provided value, then commit them.
+   * Importers not inheriting vtkF3DImporter are entirely updated in the commit.
+   */
+  bool EvaluateAtTimeValue(double timeValue) override;
+  bool CommitEvaluatedTimeValue() override;
+  ///@}
+
+  /**
+   * Set if the next time value updates are seeks on each individual importer
+   */
+  void SetSeeking(bool seeking) override;
+
   /**
    * Get the update mTime
    */
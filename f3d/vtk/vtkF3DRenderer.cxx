@@ -3,6 +3,8 @@
 #include "F3DColoringInfoHandler.h"
 #include "F3DDefaultHDRI.h"
 #include "F3DLog.h"
+#include "F3DUtils.h"
+#include "vtkF3DBVHCuller.h"
 #include "vtkF3DCachedLUTTexture.h"
 #include "vtkF3DCachedSpecularTexture.h"
 #include "vtkF3DOpenGLGridMapper.h"
@@ -12,6 +14,7 @@
 #include "vtkF3DSolidBackgroundPass.h"
 #include "vtkF3DUserRenderPass.h"
 
+#include <vtkActorCollection.h>
 #include <vtkAxesActor.h>
 #include <vtkBoundingBox.h>
 #include <vtkCamera.h>
@@ -23,6 +26,8 @@
 #include <vtkImageData.h>
 #include <vtkImageReader2.h>
 #include <vtkImageReader2Factory.h>
+#include <vtkInformation.h>
+#include <vtkInformationObjectBaseVectorKey.h>
 #include <vtkLight.h>
 #include <vtkLightCollection.h>
 #include <vtkLightKit.h>
@@ -40,6 +45,8 @@
 #include <vtkPixelBufferObject.h>
 #include <vtkPointData.h>
 #include <vtkPolyData.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkPropCollection.h>
 #include <vtkProperty.h>
 #include <vtkRenderWindow.h>
 #include <vtkSSAAPass.h>
@@ -58,8 +65,6 @@
 #include <vtkXMLMultiBlockDataWriter.h>
 #include <vtkXMLTableReader.h>
 #include <vtkXMLTableWriter.h>
-#include <vtksys/FStream.hxx>
-#include <vtksys/MD5.h>
 #include <vtksys/SystemTools.hxx>
 
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 4, 20250513)
@@ -113,32 +118,6 @@ std::string DeprecatedCollapsePath(const fs::path& path)
 }
 
 #if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 2, 20221220)
-//----------------------------------------------------------------------------
-// Compute the MD5 hash of an existing file on disk
-std::string ComputeFileHash(const std::string& filepath)
-{
-  unsigned char digest[16];
-  char md5Hash[33];
-  md5Hash[32] = '\0';
-
-  std::size_t length = vtksys::SystemTools::FileLength(filepath);
-  std::vector<char> buffer(length);
-
-  vtksys::ifstream file;
-  file.open(filepath.c_str(), std::ios_base::binary);
-  file.read(buffer.data(), length);
-
-  vtksysMD5* md5 = vtksysMD5_New();
-  vtksysMD5_Initialize(md5);
-  vtksysMD5_Append(
-    md5, reinterpret_cast<const unsigned char*>(buffer.data()), static_cast<int>(length));
-  vtksysMD5_Finalize(md5, digest);
-  vtksysMD5_DigestToHex(digest, md5Hash);
-  vtksysMD5_Delete(md5);
-
-  return md5Hash;
-}
-
 #ifndef __EMSCRIPTEN__
 //----------------------------------------------------------------------------
 // Download texture from the GPU to a vtkImageData
@@ -214,6 +193,7 @@ vtkStandardNewMacro(vtkF3DRenderer);
 //----------------------------------------------------------------------------
 vtkF3DRenderer::vtkF3DRenderer()
 {
+  // the BVH culler is added when frustum culling is enabled
   this->Cullers->RemoveAllItems();
   this->AutomaticLightCreationOff();
   this->SetClippingRangeExpansion(0.99);
@@ -1083,7 +1063,7 @@ void vtkF3DRenderer::ConfigureHDRIHash()
     else
     {
       // Compute HDRI MD5, here we know the HDRIFile is not empty
-      this->HDRIHash = ::ComputeFileHash(this->HDRIFile);
+      this->HDRIHash = F3DUtils::ComputeFileHash(this->HDRIFile);
     }
     this->HasValidHDRIHash = true;
     this->CreateCacheDirectory();
@@ -1725,6 +1705,132 @@ void vtkF3DRenderer::SetUseTrackball(bool use)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetLODThresholds(const std::vector<double>& thresholds)
+{
+  if (this->LODThresholds != thresholds)
+  {
+    this->LODThresholds = thresholds;
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::SetUseFrustumCulling(bool use)
+{
+  if ((this->BVHCuller != nullptr) == use)
+  {
+    return;
+  }
+
+  // a new culler is created each time, the hierarchy of the previous one may reference
+  // props removed in the meantime
+  if (use)
+  {
+    this->BVHCuller = vtkSmartPointer<vtkF3DBVHCuller>::New();
+    this->Cullers->AddItem(this->BVHCuller);
+  }
+  else
+  {
+    this->Cullers->RemoveItem(this->BVHCuller);
+    this->BVHCuller = nullptr;
+  }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::UpdateRenderStatistics()
+{
+  if (this->BVHCuller)
+  {
+    this->NumberOfVisibleProps = this->BVHCuller->GetNumberOfVisibleProps();
+    this->NumberOfCulledProps = this->BVHCuller->GetNumberOfCulledProps();
+    this->NumberOfSubmittedTriangles = this->BVHCuller->GetNumberOfVisibleTriangles();
+    return;
+  }
+
+  // without culler, every visible prop is rendered
+  this->NumberOfVisibleProps = 0;
+  this->NumberOfCulledProps = 0;
+  this->NumberOfSubmittedTriangles = 0;
+  vtkPropCollection* props = this->GetViewProps();
+  vtkCollectionSimpleIterator pit;
+  props->InitTraversal(pit);
+  while (vtkProp* prop = props->GetNextProp(pit))
+  {
+    if (prop->GetVisibility())
+    {
+      this->NumberOfVisibleProps++;
+      this->NumberOfSubmittedTriangles += vtkF3DBVHCuller::GetNumberOfTriangles(prop);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkF3DRenderer::UpdateLevelsOfDetail()
+{
+  vtkCamera* camera = this->GetActiveCamera();
+  const int* size = this->GetSize();
+  double tanHalfAngle = std::tan(vtkMath::RadiansFromDegrees(camera->GetViewAngle()) / 2.0);
+
+  vtkActorCollection* actors = this->GetActors();
+  vtkCollectionSimpleIterator ait;
+  actors->InitTraversal(ait);
+  while (vtkActor* actor = actors->GetNextActor(ait))
+  {
+    vtkInformation* info = actor->GetPropertyKeys();
+    int nbLevels = info ? info->Length(vtkF3DImporter::ACTOR_LOD_MAPPERS()) : 0;
+
+    // Coloring and point sprites actors copy the keys of the imported actors
+    // but use their own mapper, they are left alone
+    bool hasLevels = false;
+    for (int i = 0; i < nbLevels && !hasLevels; i++)
+    {
+      hasLevels = vtkF3DImporter::ACTOR_LOD_MAPPERS()->Get(info, i) == actor->GetMapper();
+    }
+
+    if (hasLevels)
+    {
+      int level = 0;
+      if (!this->UseFullDetail)
+      {
+        vtkBoundingBox box(actor->GetBounds());
+        double center[3];
+        box.GetCenter(center);
+        double diameter = box.GetDiagonalLength();
+
+        // Projected size of the bounding sphere, in pixels
+        double pixels;
+        if (camera->GetParallelProjection())
+        {
+          pixels = diameter / (2.0 * camera->GetParallelScale()) * size[1];
+        }
+        else
+        {
+          double distance =
+            std::sqrt(vtkMath::Distance2BetweenPoints(center, camera->GetPosition()));
+          pixels = distance > diameter / 2.0
+            ? diameter / (2.0 * distance * tanHalfAngle) * size[1]
+            : VTK_DOUBLE_MAX;
+        }
+
+        while (level < nbLevels - 1 && level < static_cast<int>(this->LODThresholds.size()) &&
+          pixels < this->LODThresholds[level])
+        {
+          level++;
+        }
+      }
+
+      vtkMapper* mapper =
+        vtkMapper::SafeDownCast(vtkF3DImporter::ACTOR_LOD_MAPPERS()->Get(info, level));
+      if (mapper && actor->GetMapper() != mapper)
+      {
+        actor->SetMapper(mapper);
+      }
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::UpdateActors()
 {
@@ -1800,9 +1906,12 @@ void vtkF3DRenderer::UpdateActors()
 //----------------------------------------------------------------------------
 void vtkF3DRenderer::Render()
 {
+  this->UpdateLevelsOfDetail();
+
   if (!this->TimerVisible)
   {
     this->Superclass::Render();
+    this->UpdateRenderStatistics();
     return;
   }
 
@@ -1817,6 +1926,7 @@ void vtkF3DRenderer::Render()
 #endif
 
   this->Superclass::Render();
+  this->UpdateRenderStatistics();
 
   auto cpuElapsed = std::chrono::high_resolution_clock::now() - cpuStart;
 
@@ -1839,6 +1949,7 @@ void vtkF3DRenderer::Render()
     elapsedTime = std::min(elapsedTime, elapsed * 1e-9);
 #endif
 
+    this->FrameTime = elapsedTime;
     // b this->UIActor->UpdateFpsValue(elapsedTime);
   }
 }
@@ -25,6 +25,7 @@
 namespace fs = std::filesystem;
 
 class vtkDiscretizableColorTransferFunction;
+class vtkF3DBVHCuller;
 class vtkColorTransferFunction;
 class vtkCornerAnnotation;
 class vtkGridAxesActor3D;
@@ -128,6 +129,46 @@ public:
   vtkGetMacro(InvertZoom, bool);
   ///@}
 
+  /**
+   * Set the projected sizes, in pixels, below which actors providing levels of detail
+   * through vtkF3DImporter::ACTOR_LOD_MAPPERS switch to the next level.
+   * Sizes are expected in decreasing order, the Nth size selecting the Nth decimated level.
+   */
+  void SetLODThresholds(const std::vector<double>& thresholds);
+
+  /**
+   * Set if props outside of the camera frustum are culled before rendering.
+   * The BVH culler is only installed when it is enabled. It is disabled by default,
+   * as props outside of the camera frustum may still be needed by other views of the scene.
+   */
+  void SetUseFrustumCulling(bool use);
+
+  ///@{
+  /**
+   * Set/Get if actors should always be rendered at full detail, ignoring their levels of detail
+   */
+  vtkSetMacro(UseFullDetail, bool);
+  vtkGetMacro(UseFullDetail, bool);
+  ///@}
+
+  /**
+   * Get the number of triangles submitted by the actors not culled during the last render
+   */
+  vtkGetMacro(NumberOfSubmittedTriangles, vtkIdType);
+
+  /**
+   * Get the time in seconds of the last render, only measured when the timer is shown
+   */
+  vtkGetMacro(FrameTime, double);
+
+  ///@{
+  /**
+   * Get the number of props rendered and culled outside of the view frustum during the last render
+   */
+  vtkGetMacro(NumberOfVisibleProps, int);
+  vtkGetMacro(NumberOfCulledProps, int);
+  ///@}
+
   /**
    * Reimplemented to configure:
    *  - ActorsProperties
@@ -438,6 +479,17 @@ private:
    */
   void ConfigureTextActors();
 
+  /**
+   * Select the level of detail of each actor providing them, based on its projected size
+   */
+  void UpdateLevelsOfDetail();
+
+  /**
+   * Update the numbers of visible and culled props and of submitted triangles
+   * from the BVH culler, or from the visible props when culling is disabled
+   */
+  void UpdateRenderStatistics();
+
   ///@{
   /**
    * Configure HDRI actor and related lighting textures
@@ -531,6 +583,7 @@ private:
 
   vtkNew<vtkActor> GridActor;
   vtkNew<vtkSkybox> SkyboxActor;
+  vtkSmartPointer<vtkF3DBVHCuller> BVHCuller; // only set when culling is enabled
   // vtkNew<vtkF3DUIActor> UIActor;
 
   unsigned int Timer = 0; // Timer OpenGL query
@@ -577,6 +630,12 @@ private:
   std::optional<bool> UseOrthographicProjection = false;
   bool UseTrackball = false;
   bool InvertZoom = false;
+  bool UseFullDetail = false;
+  std::vector<double> LODThresholds;
+  vtkIdType NumberOfSubmittedTriangles = 0;
+  int NumberOfVisibleProps = 0;
+  int NumberOfCulledProps = 0;
+  double FrameTime = 0;
 
   int RaytracingSamples = 0;
   double UpVector[3] = { 0.0, 1.0, 0.0 };
@@ -300,6 +300,9 @@ void window_impl::UpdateDynamicOptions()
   renderer->SetPointSpritesProperties(splatType, pointSpritesSize);
 
   renderer->SetLineWidth(opt.render.line_width);
+  renderer->SetLODThresholds(opt.render.lod.thresholds);
+  renderer->SetUseFullDetail(opt.render.lod.full_detail);
+  renderer->SetUseFrustumCulling(opt.render.culling);
   renderer->SetPointSize(opt.render.point_size);
   renderer->ShowEdge(opt.render.show_edges);
   renderer->ShowTimer(opt.ui.fps);
@@ -517,6 +520,12 @@ void window_impl::SetCachePath(const fs::path& cachePath)
   this->Internals->CachePath = cachePath;
 }
 
+//----------------------------------------------------------------------------
+const fs::path& window_impl::GetCachePath() const
+{
+  return this->Internals->CachePath;
+}
+
 //----------------------------------------------------------------------------
 //void window_impl::SetInteractor(interactor_impl* interactor)
 void window_impl::SetInteractor(vtkRenderWindowInteractor* interactor)
@@ -111,6 +111,12 @@ public:
    */
   void SetCachePath(const std::filesystem::path& cachePath);
 
+  /**
+   * Implementation only API.
+   * Get the cache path, empty if not set.
+   */
+  const std::filesystem::path& GetCachePath() const;
+
   /**
    * Implementation only API.
    * Set the interactor to use when recovering bindings documentation.
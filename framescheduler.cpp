@@ -0,0 +1,73 @@
+#include "framescheduler.h"
+
+#include <QGuiApplication>
+#include <QScreen>
+
+namespace DS
+{
+FrameScheduler::FrameScheduler(QObject* parent) : QObject(parent)
+{
+	_timer.setSingleShot(true);
+	_timer.setTimerType(Qt::PreciseTimer);
+	connect(&_timer, &QTimer::timeout, this, &FrameScheduler::wakeup);
+	_clock.start();
+}
+
+void FrameScheduler::requestFrame(Dirty reason)
+{
+	_dirty |= reason;
+	schedule();
+}
+
+void FrameScheduler::setAnimating(bool animating)
+{
+	_animating = animating;
+	if (animating) {
+		requestFrame(Animation);
+	}
+	else {
+		_dirty &= ~DirtyFlags(Animation);
+		if (!_dirty)
+			_timer.stop();
+	}
+}
+
+int FrameScheduler::wakeupsPerSecond()
+{
+	qint64 now = _clock.elapsed();
+	while (!_wakeups.empty() && _wakeups.front() <= now - 1000)
+		_wakeups.pop_front();
+	return static_cast<int>(_wakeups.size());
+}
+
+int FrameScheduler::frameInterval() const
+{
+	QScreen* screen = QGuiApplication::primaryScreen();
+	double rate = screen ? screen->refreshRate() : 0;
+	if (rate <= 0)
+		rate = 60;
+	return qMax(1, qRound(1000 / rate));
+}
+
+void FrameScheduler::schedule()
+{
+	if (_timer.isActive() || !_dirty)
+		return;
+
+	// Frames are paced to the display refresh, a request right after a frame waits for the next one
+	qint64 next = _lastframe + frameInterval();
+	_timer.start(static_cast<int>(qMax<qint64>(0, next - _clock.elapsed())));
+}
+
+void FrameScheduler::wakeup()
+{
+	_lastframe = _clock.elapsed();
+	_wakeups.push_back(_lastframe);
+	wakeupsPerSecond();
+
+	DirtyFlags dirty = _dirty;
+	_dirty = _animating ? DirtyFlags(Animation) : DirtyFlags();
+	emit frame(dirty);
+	schedule();
+}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+
+#include <deque>
+
+namespace DS
+{
+// Wakes the GUI thread up only when a frame has to be produced: at the display refresh
+// rate while animating, once when something else became dirty, and never when idle
+class FrameScheduler : public QObject
+{
+	Q_OBJECT
+public:
+	enum Dirty
+	{
+		Animation	= 1 << 0,
+		Camera		= 1 << 1,
+		Options		= 1 << 2,
+		Scene		= 1 << 3,
+	};
+	Q_DECLARE_FLAGS(DirtyFlags, Dirty)
+
+	FrameScheduler(QObject* parent = nullptr);
+
+	// Request a frame, requests received before the next frame are merged into it
+	void requestFrame(Dirty reason);
+
+	// Produce a frame at each display refresh until disabled
+	void setAnimating(bool animating);
+	bool isAnimating() const { return _animating; }
+
+	// Number of wakeups during the last second
+	int wakeupsPerSecond();
+
+signals:
+	void frame(DS::FrameScheduler::DirtyFlags dirty);
+
+private:
+	int frameInterval() const;
+	void schedule();
+	void wakeup();
+
+	QTimer				_timer;
+	QElapsedTimer		_clock;
+	qint64				_lastframe = 0;	// ms since _clock started
+	DirtyFlags			_dirty;
+	bool				_animating = false;
+	std::deque<qint64>	_wakeups;		// times of the wakeups of the last second
+};
+}
+Q_DECLARE_OPERATORS_FOR_FLAGS(DS::FrameScheduler::DirtyFlags)
@@ -44,6 +44,15 @@ ApplicationWindow {
                 VtkItem {                
                     objectName: "vtkItem"
                     anchors.fill: parent
+                    // not a binding, the mode is fixed once the item was rendered
+                    Component.onCompleted: threadedRendering = options.threadedRendering
+                }
+                Label {
+                    id: frameStatsLabel
+                    anchors.left: parent.left
+                    anchors.top: parent.top
+                    anchors.margins: 8
+                    visible: text.length > 0
                 }
             }
             Slider {
@@ -191,10 +200,49 @@ ApplicationWindow {
         objectName: "openProjectDialog"        
         nameFilters: ["FBX files (*.fbx)","All files (*)"]
         onAccepted: {
-            if (!projectManager.openSource(file)) openFileErrorDlg.open 
+            if (projectManager.openSource(file)) loadingPopup.open()
+            else openFileErrorDlg.open()
         }
     } 
 
+    Connections {
+        target: projectManager
+        function onLoadProgress(progress) { loadingBar.value = progress }
+        function onLoadFinished(success) {
+            loadingPopup.close()
+            if (!success) openFileErrorDlg.open()
+        }
+        function onLoadCanceled() { loadingPopup.close() }
+        function onFrameStats(frameTime, triangles, visibleProps, culledProps, droppedFrames, wakeups) {
+            frameStatsLabel.text = (frameTime > 0 ? Math.round(1 / frameTime) + " fps, " : "")
+                + triangles.toLocaleString(Qt.locale(), "f", 0) + " triangles, "
+                + visibleProps + " visible / " + culledProps + " culled actors"
+                + (droppedFrames > 0 ? ", " + droppedFrames + " dropped frames" : "")
+                + ", " + wakeups + " wakeups/s"
+        }
+    }
+
+    Popup {
+        id: loadingPopup
+        parent: Overlay.overlay
+        anchors.centerIn: parent
+        modal: true
+        closePolicy: Popup.NoAutoClose
+        onOpened: loadingBar.value = 0
+        ColumnLayout {
+            Label { text: qsTr("Loading...") }
+            ProgressBar {
+                id: loadingBar
+                Layout.preferredWidth: 300
+            }
+            Button {
+                text: qsTr("Cancel")
+                Layout.alignment: Qt.AlignRight
+                onClicked: projectManager.cancelLoad()
+            }
+        }
+    }
+
     AboutDialog {
         id: aboutDialog
         parent: Overlay.overlay
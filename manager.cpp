@@ -1,19 +1,15 @@
-#include <QStandardItemModel>
 #include <QStringList>
-#include <QThread>
 
 #include "app.h"
 #include "vtkitem.h"
 #include "manager.h"
 #include "settings.h"
 
-#include "assimp/mesh.h"
-
 namespace DS
 {
 Manager::Manager(QQmlEngine* engine) 
 {
-	_treemodel = new QStandardItemModel(engine);
+	_treemodel = new SceneGraphModel(engine);
 	_listmodel = new QStringListModel(engine);
 }
 
@@ -21,8 +17,7 @@ void Manager::setConnect()
 {
 	_vtk->setupOpt();
 
-	connect(&_timer, &QTimer::timeout, this, &Manager::timerSlot);
-	_timer.start();
+	connect(&_scheduler, &FrameScheduler::frame, this, &Manager::onFrame);
 }
 
 bool Manager::openSource(const QUrl& url, bool clear)
@@ -31,79 +26,70 @@ bool Manager::openSource(const QUrl& url, bool clear)
 	return _vtk->openSource(clear);
 }
 
-void Manager::playToggle()
+void Manager::cancelLoad()
 {
-	_vtk->play();
-	double d = _vtk->_animanager->TimeRange[1] - _vtk->_animanager->TimeRange[0];
-	_step = 1.0 / (30 * d);
+	_vtk->cancelLoad();
 }
 
-void Manager::setTreeModel(vtkF3DAssimpImporter* importer, bool clear)
+void Manager::playToggle()
 {
-	if (clear)
-		_treemodel->removeRows(0, _treemodel->rowCount());
-
-	const aiNode* root = _vtk->_aiscene->mRootNode;
-	QStandardItem* item = _treemodel->invisibleRootItem();
-	item->setData(QString(root->mName.C_Str()), Qt::DisplayRole);
-	item->setData(QVariant::fromValue<const aiNode*>(root));
-	for (int i = 0; i < root->mNumChildren; i++)
-		traversTree(item, root->mChildren[i]);
+	_vtk->play();
 }
 
-void Manager::traversTree(QStandardItem* parent, const aiNode* node)
+void Manager::setTreeModel()
 {
-	if (node != nullptr && !node->mNumMeshes) {		
-		QStandardItem* item = new QStandardItem();
-		item->setData(QString(node->mName.C_Str()), Qt::DisplayRole);
-		item->setData(QVariant::fromValue<const aiNode*>(node));
-		parent->appendRow(item);
-		for (int i = 0; i < node->mNumChildren; i++)
-			traversTree(item, node->mChildren[i]);
-	}
+	_treemodel->setSceneGraph(_vtk->_scenegraph);
 }
 
 void Manager::treeSelChanged(const QModelIndex& idx)
 {
-	if (!idx.isValid() || !idx.data(Qt::UserRole + 1).isValid()) {
+	if (!idx.isValid() || !idx.data(SceneGraphModel::NodeIndexRole).isValid()) {
 		qDebug() << "Tree model index is invalid!";
 		return;
 	}
-	const aiNode* node = idx.data(Qt::UserRole + 1).value<const aiNode*>();
-	if (!node) {
+	const auto& graph = _vtk->_scenegraph;
+	int nodeIndex = idx.data(SceneGraphModel::NodeIndexRole).toInt();
+	if (!graph || nodeIndex < 0 || nodeIndex >= static_cast<int>(graph->Nodes.size())) {
 		qDebug() << "Tree model data is invalid!";
 		return;
 	}
 	QStringList list;
-	list << "Node name: " + QString(node->mName.C_Str());
-
-	std::vector<aiBone*> vbone;
-	std::for_each(&_vtk->_aiscene->mMeshes[0], &_vtk->_aiscene->mMeshes[_vtk->_aiscene->mNumMeshes], [&](aiMesh* mesh) {
-		std::for_each(&mesh->mBones[0], &mesh->mBones[mesh->mNumBones], [&](aiBone* bone) {
-			if (bone->mNode == node)
-				vbone.emplace_back(bone);
-			});
-		});
-	std::sort(vbone.begin(), vbone.end(), [](const aiBone* a, const aiBone* b) {
-		return a->mNumWeights > b->mNumWeights;
-		});
-	if (vbone.size()) {
-		aiBone* b = vbone[0];
-		auto m = b->mOffsetMatrix;
-		list << QString::asprintf("%+.3f", m.a1) + ";" + QString::asprintf("%+.3f", m.a2) + ";" + QString::asprintf("%+.3f", m.a3) + ";" + QString::asprintf("%+.3f", m.a4);
-		list << QString::asprintf("%+.3f", m.b1) + ";" + QString::asprintf("%+.3f", m.b2) + ";" + QString::asprintf("%+.3f", m.b3) + ";" + QString::asprintf("%+.3f", m.b4);
-		list << QString::asprintf("%+.3f", m.c1) + ";" + QString::asprintf("%+.3f", m.c2) + ";" + QString::asprintf("%+.3f", m.c3) + ";" + QString::asprintf("%+.3f", m.c4);
-		list << QString::asprintf("%+.3f", m.d1) + ";" + QString::asprintf("%+.3f", m.d2) + ";" + QString::asprintf("%+.3f", m.d3) + ";" + QString::asprintf("%+.3f", m.d4);
-	}		
+	list << "Node name: " + QString::fromStdString(graph->Nodes[nodeIndex].Name);
+
+	// the bones of each node are indexed at load, the one with the most weights first
+	auto found = graph->NodeBones.find(nodeIndex);
+	if (found != graph->NodeBones.end()) {
+		const auto& bone = graph->Bones[found->second.front()];
+		list << "Weights: " + QString::number(bone.NumberOfWeights);
+		const double* m = bone.OffsetMatrix;
+		for (int i = 0; i < 4; i++)
+			list << QString::asprintf("%+.3f", m[4 * i]) + ";" + QString::asprintf("%+.3f", m[4 * i + 1]) + ";" + QString::asprintf("%+.3f", m[4 * i + 2]) + ";" + QString::asprintf("%+.3f", m[4 * i + 3]);
+	}
 	_listmodel->setStringList(list);
 }
 
-void Manager::timerSlot()
+void Manager::onFrame(FrameScheduler::DirtyFlags dirty)
 {
-	if (_vtk->_playf) {
-		_vtk->timerCall();
-		setSliderVal(_sliderval + _step);
+	if (!(dirty & FrameScheduler::Animation)) {
+		_vtk->requestRender();
+		return;
 	}
+
+	// playback may have been stopped on the render thread by a seek, a load or a close
+	if (!_vtk->_playf) {
+		_scheduler.setAnimating(false);
+		return;
+	}
+	// the slider follows the animation time computed on the render thread, ticks do not
+	// match frames in real-time playback
+	_vtk->tick().then(this, [this](std::optional<double> position) {
+		if (!position) {
+			_scheduler.setAnimating(false);
+			return;
+		}
+		_sliderval = *position;
+		emit sliderValChanged();
+		});
 }
 
 void Manager::setSliderVal(double val)
@@ -122,6 +108,14 @@ void Manager::onMoved(double val)
 	_vtk->sliderMove();
 }
 
+QVariantList Manager::commandLatencies() const
+{
+	QVariantList list;
+	for (int count : _vtk->commandLatencies())
+		list << count;
+	return list;
+}
+
 void Manager::closeSource()
 {
     _vtk->close();
@@ -129,21 +123,21 @@ void Manager::closeSource()
 
 void Manager::cameraReset()
 {
-    _vtk->dispatch_async([&](vtkRenderWindow* renderWindow, VtkItem::vtkUserData userData) {
-        VtkItem::Data* vtk = (VtkItem::Data*)userData.GetPointer();
+    _vtk->command<void>(VtkItem::Command::CameraReset, [](vtkRenderWindow* renderWindow, VtkItem::Data* vtk) {
         vtk->_win->getCamera().resetToBounds();
     });
-    QThread::msleep(10);
+    _scheduler.requestFrame(FrameScheduler::Camera);
 }
 
 void Manager::showAxis()
 {
-    _vtk->dispatch_async([&](vtkRenderWindow* renderWindow, VtkItem::vtkUserData userData) {
-        VtkItem::Data* vtk = (VtkItem::Data*)userData.GetPointer();
-        _options->setShowAxis(!_options->showAxis());
-        vtk->_win->Internals->Renderer->ShowAxis(_options->showAxis());
+    // the setting belongs to the GUI thread, only the renderer is updated on the render thread
+    bool show = !_options->showAxis();
+    _options->setShowAxis(show);
+    _vtk->command<void>(VtkItem::Command::ShowAxis, [show](vtkRenderWindow* renderWindow, VtkItem::Data* vtk) {
+        vtk->_win->Internals->Renderer->ShowAxis(show);
     });
-    QThread::msleep(10);
+    _scheduler.requestFrame(FrameScheduler::Options);
 }
 
 }
@@ -6,12 +6,11 @@
 #include <QUrl>
 #include <QQuickItem>
 #include <QModelIndex>
-#include <QStandardItemModel>
 #include <QStringListModel>
-#include <QTimer>
 
-class aiScene;
-class aiNode;
+#include "framescheduler.h"
+#include "scenegraphmodel.h"
+
 class vtkF3DAssimpImporter;
 namespace DS
 {
@@ -22,42 +21,48 @@ class Manager : public QObject
 	Q_OBJECT
     QML_ELEMENT
 	Q_PROPERTY(double sliderVal READ sliderVal WRITE setSliderVal NOTIFY sliderValChanged)
-    Q_PROPERTY(QStandardItemModel* treeModel MEMBER _treemodel NOTIFY    treeModelChanged)
+    Q_PROPERTY(QAbstractItemModel* treeModel READ treeModel NOTIFY    treeModelChanged)
     Q_PROPERTY(QStringListModel*   listModel MEMBER _listmodel NOTIFY    listModelChanged)
 
 public:
 	Manager(QQmlEngine* engine);
 	
-	QStandardItemModel*	_treemodel = nullptr;
+	SceneGraphModel*	_treemodel = nullptr;
 	QStringListModel*	_listmodel = nullptr;
 	VtkItem*			_vtk = nullptr;
 	QQuickItem*			_slider = nullptr;
     Settings*           _options = nullptr;
 
-	QTimer _timer;
-	double _step = 0;
+	FrameScheduler _scheduler;
 
 	double _sliderval = 0.0;
 	double sliderVal() const { return _sliderval; }
 	void setSliderVal(double val);
 
 	void setConnect();
-	void setTreeModel(vtkF3DAssimpImporter* importer, bool clear);
-	void traversTree(QStandardItem* parent, const aiNode* node);
+	QAbstractItemModel* treeModel() const { return _treemodel; }
+	void setTreeModel();
 
 	Q_INVOKABLE bool openSource(const QUrl& url, bool clear = true);
+	Q_INVOKABLE void cancelLoad();
 	Q_INVOKABLE void playToggle();
 	Q_INVOKABLE void treeSelChanged(const QModelIndex& idx);
 	Q_INVOKABLE void onMoved(double val);
     Q_INVOKABLE void closeSource();
     Q_INVOKABLE void cameraReset();
     Q_INVOKABLE void showAxis();
+	// Histogram of the render thread commands round trips, see VtkItem::LatencyBuckets
+	Q_INVOKABLE QVariantList commandLatencies() const;
 signals:	
 	void sliderValChanged();
     void treeModelChanged();
     void listModelChanged();
+	void loadProgress(double progress);
+	void loadFinished(bool success);
+	void loadCanceled();
+	void frameStats(double frameTime, qint64 triangles, int visibleProps, int culledProps, int droppedFrames, int wakeups);
 public slots:
-	void timerSlot();
+	void onFrame(DS::FrameScheduler::DirtyFlags dirty);
 };
 
 }
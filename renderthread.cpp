@@ -0,0 +1,182 @@
+#include "renderthread.h"
+
+#include <QOpenGLFunctions>
+#include <QScreen>
+
+#include <vtkCommand.h>
+#include <vtkGenericRenderWindowInteractor.h>
+#include <vtkNew.h>
+
+namespace DS
+{
+RenderThread::RenderThread(QScreen* screen, Init init, Job cleanup)
+	: _init(std::move(init))
+	, _cleanup(std::move(cleanup))
+{
+	_surface = new QOffscreenSurface(screen);
+	_surface->setFormat(QSurfaceFormat::defaultFormat());
+	_surface->create();
+	moveToThread(&_thread);
+}
+
+RenderThread::~RenderThread()
+{
+	if (_thread.isRunning()) {
+		// release VTK and the framebuffers with the context current, on the render thread
+		QMetaObject::invokeMethod(this, [this]() {
+			if (_initialized) {
+				_context->makeCurrent(_surface);
+				if (_cleanup)
+					_cleanup(_window, _userdata);
+				_userdata = nullptr;
+				_window->Finalize();
+				_window = nullptr;
+				for (Slot& slot : _slots)
+					slot.fbo.reset();
+				_context->doneCurrent();
+			}
+			delete _context;
+			_context = nullptr;
+			_thread.quit();
+			}, Qt::BlockingQueuedConnection);
+		_thread.wait();
+	}
+	delete _context;
+	delete _surface;
+}
+
+void RenderThread::start(QOpenGLContext* shareContext, QSize size)
+{
+	_context = new QOpenGLContext();
+	_context->setFormat(shareContext->format());
+	_context->setShareContext(shareContext);
+	_context->create();
+	_context->moveToThread(&_thread);
+	_size = size;
+
+	_thread.start();
+	QMetaObject::invokeMethod(this, [this]() { initialize(); }, Qt::QueuedConnection);
+}
+
+void RenderThread::post(Job job)
+{
+	QMetaObject::invokeMethod(this, [this, job = std::move(job)]() { run(job); }, Qt::QueuedConnection);
+}
+
+void RenderThread::resize(QSize size)
+{
+	QMetaObject::invokeMethod(this, [this, size]() {
+		// sizes posted before the thread started are older than the one provided to start
+		if (!_initialized)
+			return;
+		_size = size;
+		_window->SetSize(size.width(), size.height());
+		if (_window->GetInteractor())
+			_window->GetInteractor()->UpdateSize(size.width(), size.height());
+		scheduleRender();
+		}, Qt::QueuedConnection);
+}
+
+unsigned int RenderThread::acquireFrame(QSize& size, int& slot)
+{
+	if (_ready.load() & NewFrame)
+		_present = _ready.exchange(_present) & ~NewFrame;
+
+	const Slot& present = _slots[_present];
+	if (!present.fbo)
+		return 0;
+	size = present.fbo->size();
+	slot = _present;
+	return present.fbo->texture();
+}
+
+void RenderThread::initialize()
+{
+	_context->makeCurrent(_surface);
+
+	_window = vtkSmartPointer<vtkGenericOpenGLRenderWindow>::New();
+	_window->AddObserver(vtkCommand::WindowMakeCurrentEvent, this, &RenderThread::makeCurrent);
+	_window->AddObserver(vtkCommand::WindowIsCurrentEvent, this, &RenderThread::isCurrent);
+	_window->SetOwnContext(false);
+	_window->SetFrameBlitModeToBlitToHardware();
+	_window->SetForceMaximumHardwareLineWidth(1);
+	_window->SetReadyForRendering(true);
+	_window->SetSize(_size.width(), _size.height());
+
+	vtkNew<vtkGenericRenderWindowInteractor> interactor;
+	interactor->SetRenderWindow(_window);
+	interactor->Initialize();
+
+	_window->OpenGLInitContext();
+	bindWriteSlot();
+
+	_userdata = _init(_window);
+	_initialized = true;
+
+	std::vector<Job> pending;
+	pending.swap(_pending);
+	for (const Job& job : pending)
+		job(_window, _userdata);
+	scheduleRender();
+}
+
+void RenderThread::run(Job job)
+{
+	if (!_initialized) {
+		_pending.emplace_back(std::move(job));
+		return;
+	}
+	_context->makeCurrent(_surface);
+	job(_window, _userdata);
+	scheduleRender();
+}
+
+void RenderThread::scheduleRender()
+{
+	// jobs queued before the render runs share the same frame
+	if (_renderpending)
+		return;
+	_renderpending = true;
+	QMetaObject::invokeMethod(this, [this]() { render(); }, Qt::QueuedConnection);
+}
+
+void RenderThread::render()
+{
+	_renderpending = false;
+	if (!_initialized || _size.isEmpty())
+		return;
+
+	_context->makeCurrent(_surface);
+	bindWriteSlot();
+	_window->Render();
+
+	// the scene graph context samples the texture without synchronizing with this one
+	_context->functions()->glFinish();
+
+	_write = _ready.exchange(_write | NewFrame) & ~NewFrame;
+	bindWriteSlot();
+	emit frameReady();
+}
+
+void RenderThread::bindWriteSlot()
+{
+	// every render, including the ones started by the jobs, goes to the slot owned by this thread
+	if (_size.isEmpty())
+		return;
+	Slot& slot = _slots[_write];
+	if (!slot.fbo || slot.fbo->size() != _size) {
+		slot.fbo = std::make_unique<QOpenGLFramebufferObject>(_size, QOpenGLFramebufferObject::Depth);
+	}
+	_window->SetDefaultFrameBufferId(slot.fbo->handle());
+}
+
+void RenderThread::makeCurrent(vtkObject*, unsigned long, void*)
+{
+	_context->makeCurrent(_surface);
+}
+
+void RenderThread::isCurrent(vtkObject*, unsigned long, void* callData)
+{
+	*static_cast<bool*>(callData) = QOpenGLContext::currentContext() == _context;
+}
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <QObject>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QSize>
+#include <QThread>
+
+#include <vtkGenericOpenGLRenderWindow.h>
+#include <vtkSmartPointer.h>
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace DS
+{
+// Renders VTK on its own thread and OpenGL context, into offscreen framebuffers.
+// Finished frames are handed to the Qt Quick scene graph through a triple buffer:
+// the render thread always owns one framebuffer to draw into, the scene graph owns the
+// one it displays, and the third one is the latest finished frame, swapped atomically.
+// A slow frame never blocks the scene graph, which keeps displaying the previous one.
+class RenderThread : public QObject
+{
+	Q_OBJECT
+public:
+	using Job = std::function<void(vtkRenderWindow*, vtkObject*)>;
+	static constexpr int NbSlots = 3;
+	using Init = std::function<vtkSmartPointer<vtkObject>(vtkRenderWindow*)>;
+
+	// Must be called on the GUI thread, the offscreen surface is created there
+	RenderThread(QScreen* screen, Init init, Job cleanup);
+	~RenderThread() override;
+
+	// Create the context sharing textures with the current scene graph context, and start
+	// the thread. Must be called on the scene graph render thread, in updatePaintNode.
+	void start(QOpenGLContext* shareContext, QSize size);
+	bool isStarted() const { return _thread.isRunning(); }
+
+	// Run a job on the render thread, then render a frame. Jobs posted before the
+	// thread is initialized are run once it is
+	void post(Job job);
+	void resize(QSize size);
+
+	// Scene graph thread: get the texture of the latest finished frame and the index of
+	// its slot, 0 if none yet. The texture stays valid until the next call, a slot keeps
+	// the same texture until it is resized
+	unsigned int acquireFrame(QSize& size, int& slot);
+
+signals:
+	void frameReady();
+
+private:
+	struct Slot
+	{
+		std::unique_ptr<QOpenGLFramebufferObject> fbo;
+	};
+	static constexpr int NewFrame = 4; // flag set in _ready when it holds an unread frame
+
+	void initialize();
+	void run(Job job);
+	void scheduleRender();
+	void render();
+	void bindWriteSlot();
+	void makeCurrent(vtkObject*, unsigned long, void*);
+	void isCurrent(vtkObject*, unsigned long, void* callData);
+
+	QThread								_thread;
+	QOffscreenSurface*					_surface = nullptr;
+	QOpenGLContext*						_context = nullptr;
+	vtkSmartPointer<vtkGenericOpenGLRenderWindow> _window;
+	vtkSmartPointer<vtkObject>			_userdata;
+	Init								_init;
+	Job									_cleanup;
+
+	// render thread only
+	bool								_initialized = false;
+	bool								_renderpending = false;
+	std::vector<Job>					_pending;
+	QSize								_size;
+
+	std::array<Slot, NbSlots>			_slots;
+	int									_write = 0;		// render thread
+	int									_present = 1;	// scene graph thread
+	std::atomic<int>					_ready = 2;		// slot index | NewFrame
+};
+}
@@ -0,0 +1,105 @@
+#include "scenegraphmodel.h"
+
+#include <algorithm>
+
+namespace DS
+{
+SceneGraphModel::SceneGraphModel(QObject* parent) : QAbstractItemModel(parent)
+{
+}
+
+void SceneGraphModel::setSceneGraph(std::shared_ptr<const SceneGraph> graph)
+{
+	if (graph == _graph)
+		return;
+	beginResetModel();
+	_graph = std::move(graph);
+	_children.clear();
+	endResetModel();
+}
+
+int SceneGraphModel::nodeIndex(const QModelIndex& index) const
+{
+	// the invisible root is the root node of the graph
+	return index.isValid() ? static_cast<int>(index.internalId()) : 0;
+}
+
+const std::vector<int>& SceneGraphModel::visibleChildren(int node) const
+{
+	auto found = _children.find(node);
+	if (found != _children.end())
+		return found->second;
+
+	// nodes with meshes are not part of the skeleton, neither are their children
+	std::vector<int>& children = _children[node];
+	for (int child : _graph->Nodes[node].Children) {
+		if (!_graph->Nodes[child].NumberOfMeshes)
+			children.emplace_back(child);
+	}
+	return children;
+}
+
+QModelIndex SceneGraphModel::index(int row, int column, const QModelIndex& parent) const
+{
+	if (!hasIndex(row, column, parent))
+		return QModelIndex();
+	return createIndex(row, column, quintptr(visibleChildren(nodeIndex(parent))[row]));
+}
+
+QModelIndex SceneGraphModel::parent(const QModelIndex& child) const
+{
+	if (!child.isValid())
+		return QModelIndex();
+	int parent = _graph->Nodes[nodeIndex(child)].Parent;
+	if (parent <= 0)
+		return QModelIndex();
+
+	const std::vector<int>& siblings = visibleChildren(_graph->Nodes[parent].Parent);
+	int row = static_cast<int>(std::find(siblings.begin(), siblings.end(), parent) - siblings.begin());
+	return createIndex(row, 0, quintptr(parent));
+}
+
+int SceneGraphModel::rowCount(const QModelIndex& parent) const
+{
+	if (!_graph || _graph->Nodes.empty() || parent.column() > 0)
+		return 0;
+	return static_cast<int>(visibleChildren(nodeIndex(parent)).size());
+}
+
+int SceneGraphModel::columnCount(const QModelIndex& parent) const
+{
+	return 1;
+}
+
+bool SceneGraphModel::hasChildren(const QModelIndex& parent) const
+{
+	// answered without listing the children, the view asks it for every displayed row
+	if (!_graph || _graph->Nodes.empty() || parent.column() > 0)
+		return false;
+	const std::vector<int>& children = _graph->Nodes[nodeIndex(parent)].Children;
+	return std::any_of(children.begin(), children.end(),
+		[this](int child) { return !_graph->Nodes[child].NumberOfMeshes; });
+}
+
+QVariant SceneGraphModel::data(const QModelIndex& index, int role) const
+{
+	if (!index.isValid())
+		return QVariant();
+	int node = nodeIndex(index);
+	switch (role) {
+	case Qt::DisplayRole:
+		return QString::fromStdString(_graph->Nodes[node].Name);
+	case NodeIndexRole:
+		return node;
+	default:
+		return QVariant();
+	}
+}
+
+QHash<int, QByteArray> SceneGraphModel::roleNames() const
+{
+	QHash<int, QByteArray> roles = QAbstractItemModel::roleNames();
+	roles[NodeIndexRole] = "nodeIndex";
+	return roles;
+}
+}
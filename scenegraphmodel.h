@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QAbstractItemModel>
+
+#include "vtkF3DAssimpImporter.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace DS
+{
+// Tree of the nodes without meshes of an imported scene graph, read directly from its node
+// table. The root node is hidden, the internal id of an index is its node index.
+// Setting a graph is O(1): the visible children of a node are only listed the first time
+// the view asks for them, when it expands the node
+class SceneGraphModel : public QAbstractItemModel
+{
+	Q_OBJECT
+public:
+	using SceneGraph = vtkF3DAssimpImporter::SceneGraph;
+	static constexpr int NodeIndexRole = Qt::UserRole + 1;
+
+	SceneGraphModel(QObject* parent = nullptr);
+
+	void setSceneGraph(std::shared_ptr<const SceneGraph> graph);
+
+	QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+	QModelIndex parent(const QModelIndex& child) const override;
+	int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+	int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+	bool hasChildren(const QModelIndex& parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+	QHash<int, QByteArray> roleNames() const override;
+
+private:
+	int nodeIndex(const QModelIndex& index) const;
+	const std::vector<int>& visibleChildren(int node) const;
+
+	std::shared_ptr<const SceneGraph> _graph;
+	mutable std::unordered_map<int, std::vector<int>> _children; // listed children, by node
+};
+}
@@ -32,6 +32,26 @@ bool Settings::defaultShowAxis() const
 	return false;
 }
 
+bool Settings::threadedRendering() const
+{
+	return contains("threadedRendering") ? value("threadedRendering").toBool() : defaultThreadedRendering();
+}
+
+void Settings::setThreadedRendering(bool threaded)
+{
+	const bool existingValue = value("threadedRendering", defaultThreadedRendering()).toBool();
+	if (threaded == existingValue)
+		return;
+
+	setValue("threadedRendering", threaded);
+	emit threadedRenderingChanged();
+}
+
+bool Settings::defaultThreadedRendering() const
+{
+	return false;
+}
+
 void Settings::storeIt()
 {
 	sync();
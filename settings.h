@@ -18,6 +18,7 @@ class Settings : public QSettings
 {
     Q_OBJECT
         Q_PROPERTY(bool showAxis READ showAxis WRITE setShowAxis NOTIFY showAxisChanged)
+        Q_PROPERTY(bool threadedRendering READ threadedRendering WRITE setThreadedRendering NOTIFY threadedRenderingChanged)
         QML_ELEMENT
 public:
     Settings(QObject* parent = nullptr);
@@ -26,6 +27,11 @@ public:
     void setShowAxis(bool show);
     bool defaultShowAxis() const;
 
+    // Read once when the viewport is created, a change applies on the next start
+    bool threadedRendering() const;
+    void setThreadedRendering(bool threaded);
+    bool defaultThreadedRendering() const;
+
     //===========================
     struct interactor {
         bool invert_zoom = false;
@@ -165,5 +171,6 @@ public:
     Q_INVOKABLE void storeIt();
 signals:
     void showAxisChanged();
+    void threadedRenderingChanged();
 };
 }
\ No newline at end of file
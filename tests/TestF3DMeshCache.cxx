@@ -0,0 +1,228 @@
+#include "F3DMeshCache.h"
+
+#include <vtkCellArray.h>
+#include <vtkFloatArray.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+
+#include <assimp/scene.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+namespace fs = std::filesystem;
+
+#define CHECK(condition)                                                                           \
+  if (!(condition))                                                                                \
+  {                                                                                                \
+    std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl;        \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+//----------------------------------------------------------------------------
+std::unique_ptr<aiScene> CreateScene()
+{
+  auto scene = std::make_unique<aiScene>();
+
+  scene->mNumMaterials = 1;
+  scene->mMaterials = new aiMaterial*[1] { new aiMaterial() };
+  aiString materialName("material");
+  scene->mMaterials[0]->AddProperty(&materialName, AI_MATKEY_NAME);
+
+  scene->mNumMeshes = 1;
+  scene->mMeshes = new aiMesh*[1] { new aiMesh() };
+  scene->mMeshes[0]->mName = aiString("mesh");
+
+  scene->mRootNode = new aiNode("root");
+  scene->mRootNode->mNumMeshes = 1;
+  scene->mRootNode->mMeshes = new unsigned int[1] { 0 };
+
+  aiNodeAnim* channel = new aiNodeAnim();
+  channel->mNodeName = aiString("root");
+  channel->mNumPositionKeys = 2;
+  channel->mPositionKeys = new aiVectorKey[2];
+  channel->mPositionKeys[0] = aiVectorKey(0.0, aiVector3D(0, 0, 0));
+  channel->mPositionKeys[1] = aiVectorKey(1.0, aiVector3D(1, 2, 3));
+
+  aiAnimation* animation = new aiAnimation();
+  animation->mName = aiString("animation");
+  animation->mDuration = 1.0;
+  animation->mNumChannels = 1;
+  animation->mChannels = new aiNodeAnim*[1] { channel };
+  scene->mNumAnimations = 1;
+  scene->mAnimations = new aiAnimation*[1] { animation };
+
+  return scene;
+}
+
+//----------------------------------------------------------------------------
+std::vector<vtkSmartPointer<vtkPolyData>> CreateMeshes()
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0, 0, 0);
+  points->InsertNextPoint(1, 0, 0);
+  points->InsertNextPoint(0, 1, 0);
+
+  vtkNew<vtkFloatArray> normals;
+  normals->SetName("Normals");
+  normals->SetNumberOfComponents(3);
+  for (int i = 0; i < 3; i++)
+  {
+    normals->InsertNextTuple3(0, 0, 1);
+  }
+
+  vtkNew<vtkCellArray> polys;
+  vtkIdType triangle[3] = { 0, 1, 2 };
+  polys->InsertNextCell(3, triangle);
+
+  auto mesh = vtkSmartPointer<vtkPolyData>::New();
+  mesh->SetPoints(points);
+  mesh->SetPolys(polys);
+  mesh->GetPointData()->SetNormals(normals);
+  return { mesh };
+}
+
+//----------------------------------------------------------------------------
+void WriteSource(const fs::path& path, const std::string& content)
+{
+  std::ofstream out(path, std::ios_base::binary | std::ios_base::trunc);
+  out << content;
+}
+
+//----------------------------------------------------------------------------
+// Read the cache file with the key and check it is the scene written by the test
+bool ReadBack(const std::string& path, const F3DMeshCache::Key& key)
+{
+  std::vector<vtkSmartPointer<vtkPolyData>> meshes;
+  std::unique_ptr<aiScene> scene = F3DMeshCache::Read(path, key, meshes);
+  if (!scene || meshes.size() != 1 || scene->mNumMeshes != 1)
+  {
+    return false;
+  }
+
+  double point[3];
+  meshes[0]->GetPoint(1, point);
+  return std::string(scene->mRootNode->mName.C_Str()) == "root" &&
+    scene->mAnimations[0]->mChannels[0]->mPositionKeys[1].mValue.z == 3 &&
+    meshes[0]->GetNumberOfPolys() == 1 && meshes[0]->GetPointData()->GetNormals() &&
+    point[0] == 1;
+}
+
+//----------------------------------------------------------------------------
+// Copy a cache file and apply a change to the copy
+template<typename Change>
+std::string CopyFile(const std::string& path, const fs::path& directory, Change&& change)
+{
+  fs::path copy = directory / "copy.bin";
+  fs::copy_file(path, copy, fs::copy_options::overwrite_existing);
+  change(copy);
+  return copy.string();
+}
+}
+
+//----------------------------------------------------------------------------
+int main()
+{
+  std::random_device random;
+  fs::path directory =
+    fs::temp_directory_path() / ("TestF3DMeshCache-" + std::to_string(random()));
+  fs::create_directories(directory);
+  fs::path source = directory / "source.bin";
+  std::string cacheDirectory = (directory / "scenes").string();
+
+  std::unique_ptr<aiScene> scene = CreateScene();
+  std::vector<vtkSmartPointer<vtkPolyData>> meshes = CreateMeshes();
+
+  // write and read back
+  WriteSource(source, "first content");
+  F3DMeshCache::Key key;
+  CHECK(F3DMeshCache::GetKey(cacheDirectory, source.string(), 1, key));
+  CHECK(key.Hash.size() == 32);
+  std::string cacheFile = F3DMeshCache::GetCacheFile(cacheDirectory, key);
+  CHECK(F3DMeshCache::Write(cacheFile, key, scene.get(), meshes));
+  CHECK(ReadBack(cacheFile, key));
+
+  // unchanged source, the hash comes from the index
+  F3DMeshCache::Key sameKey;
+  CHECK(F3DMeshCache::GetKey(cacheDirectory, source.string(), 1, sameKey));
+  CHECK(sameKey.Hash == key.Hash && sameKey.SourceSize == key.SourceSize);
+
+  // stale modification time with the same content is still a hit
+  fs::last_write_time(source, fs::last_write_time(source) - std::chrono::hours(1));
+  CHECK(F3DMeshCache::GetKey(cacheDirectory, source.string(), 1, sameKey));
+  CHECK(sameKey.Hash == key.Hash);
+  CHECK(ReadBack(F3DMeshCache::GetCacheFile(cacheDirectory, sameKey), sameKey));
+
+  // modified content with the same size, only the modification time changes
+  WriteSource(source, "first CONTENT");
+  F3DMeshCache::Key modifiedKey;
+  CHECK(F3DMeshCache::GetKey(cacheDirectory, source.string(), 1, modifiedKey));
+  CHECK(modifiedKey.Hash != key.Hash && modifiedKey.SourceSize == key.SourceSize);
+  CHECK(!fs::exists(F3DMeshCache::GetCacheFile(cacheDirectory, modifiedKey)));
+  CHECK(!ReadBack(cacheFile, modifiedKey));
+
+  // modified size
+  WriteSource(source, "second, longer content");
+  F3DMeshCache::Key resizedKey;
+  CHECK(F3DMeshCache::GetKey(cacheDirectory, source.string(), 1, resizedKey));
+  CHECK(resizedKey.SourceSize != key.SourceSize);
+  CHECK(!ReadBack(cacheFile, resizedKey));
+
+  // other import settings
+  F3DMeshCache::Key otherStamp = key;
+  otherStamp.Stamp = 2;
+  CHECK(!ReadBack(cacheFile, otherStamp));
+
+  // other file version, stored after the 8 bytes magic
+  std::string otherVersion = CopyFile(cacheFile, directory,
+    [](const fs::path& path)
+    {
+      std::fstream file(path, std::ios_base::binary | std::ios_base::in | std::ios_base::out);
+      file.seekp(8);
+      file.put(static_cast<char>(0x7f));
+    });
+  CHECK(!ReadBack(otherVersion, key));
+
+  // truncated files
+  std::uintmax_t size = fs::file_size(cacheFile);
+  for (std::uintmax_t truncatedSize : { size - 1, size / 2, std::uintmax_t(16), std::uintmax_t(0) })
+  {
+    std::string truncated = CopyFile(cacheFile, directory,
+      [&](const fs::path& path) { fs::resize_file(path, truncatedSize); });
+    CHECK(!ReadBack(truncated, key));
+  }
+  fs::remove(directory / "copy.bin");
+
+  // background write of the resized source
+  std::string resizedFile = F3DMeshCache::GetCacheFile(cacheDirectory, resizedKey);
+  F3DMeshCache::WriteInBackground(resizedFile, resizedKey, scene.get(), meshes, 1ull << 30);
+  F3DMeshCache::WaitForWrites();
+  CHECK(ReadBack(resizedFile, resizedKey));
+
+  // least recently used files are removed first
+  auto now = fs::file_time_type::clock::now();
+  fs::last_write_time(cacheFile, now - std::chrono::hours(2));
+  fs::last_write_time(resizedFile, now - std::chrono::hours(1));
+  std::uintmax_t budget = 0;
+  for (const fs::directory_entry& entry : fs::directory_iterator(cacheDirectory))
+  {
+    budget += entry.path() == fs::path(cacheFile) ? 0 : entry.file_size();
+  }
+  F3DMeshCache::Trim(cacheDirectory, budget);
+  CHECK(!fs::exists(cacheFile));
+  CHECK(fs::exists(resizedFile));
+
+  F3DMeshCache::Trim(cacheDirectory, 0);
+  CHECK(fs::is_empty(cacheDirectory));
+
+  fs::remove_all(directory);
+  return EXIT_SUCCESS;
+}
@@ -2,27 +2,86 @@
 #include "manager.h"
 #include "vtkitem.h"
 
+#include <QDebug>
+#include <QGuiApplication>
+#include <QQuickWindow>
+#include <QSGRendererInterface>
+#include <QSGSimpleTextureNode>
+#include <QSGTexture>
+#include <QStandardPaths>
 #include <QThread>
 
 #include <vtkDataAssembly.h>
 #include <vtkProgressBarRepresentation.h>
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 namespace DS
 {
+namespace
+{
+// Displays the frames of the render thread. The texture wrapping the framebuffer of each
+// slot is created once, and deleted with the node on the scene graph thread
+struct FrameNode : QSGSimpleTextureNode
+{
+	struct SlotTexture
+	{
+		unsigned int id = 0;
+		QSize size;
+		std::unique_ptr<QSGTexture> texture;
+	};
+	std::array<SlotTexture, RenderThread::NbSlots> textures;
+};
+}
+
 vtkStandardNewMacro(VtkItem::Data)
 
+// A file being read on a worker thread before being added to the scene on the render thread
+struct VtkItem::LoadJob
+{
+	std::string fileName;
+	bool clear = true;
+	bool preloaded = false;
+	std::atomic<bool> canceled = false;
+	QThread* thread = nullptr; // deleted once finished, joined when the item is destroyed
+
+	std::mutex mutex;
+	std::vector<vtkSmartPointer<vtkImporter>> importers;
+};
+
+VtkItem::~VtkItem()
+{
+	// the finished connection is gone with the item, the worker is deleted here
+	if (_loadjob) {
+		cancelLoad();
+		_loadjob->thread->wait();
+		delete _loadjob->thread;
+	}
+
+	// releases VTK on the render thread before the item is gone
+	_renderthread.reset();
+}
+
 void VtkItem::setupOpt()
 {
 	_options.render.grid.enable = false;
 }
 
-void VtkItem::timerCall()
+QFuture<std::optional<double>> VtkItem::tick()
 {
-	dispatch_async([](vtkRenderWindow* renderWindow, vtkUserData userData) {
-		if (renderWindow && renderWindow->GetInteractor())
-			renderWindow->GetInteractor()->InvokeEvent(vtkCommand::InteractionEvent);
+	// Advance the animation on the render thread, the item is updated once it ran.
+	// A tick still queued when the next frame is due is not repeated.
+	// The result is the animation position in [0, 1], none when it is not playing anymore
+	return command<std::optional<double>>(Command::Tick, [this](vtkRenderWindow* renderWindow, Data* vtk) -> std::optional<double> {
+		if (!_animanager || !_animanager->IsPlaying())
+			return std::nullopt;
+		_animanager->Tick();
+		double d = _animanager->TimeRange[1] - _animanager->TimeRange[0];
+		return d > 0 ? (_animanager->CurrentTime - _animanager->TimeRange[0]) / d : 0.0;
 		});
-	QThread::msleep(10);
 }
 
 VtkItem::vtkUserData VtkItem::initializeVTK(vtkRenderWindow* renderWindow)
@@ -32,35 +91,51 @@ VtkItem::vtkUserData VtkItem::initializeVTK(vtkRenderWindow* renderWindow)
 
 	vtk->_win = new f3d::detail::window_impl(_options, f3d::window::Type::WGL, false, nullptr, renderWindow);
 	vtk->_win->SetInteractor(renderWindow->GetInteractor());
+	vtk->_win->SetCachePath(QStandardPaths::writableLocation(QStandardPaths::CacheLocation).toStdWString());
 	vtk->_scene = new f3d::detail::scene_impl(_options, *vtk->_win);
 	vtk->_scene->SetInteractor(renderWindow->GetInteractor());
 
-	vtk->_timercb = vtkSmartPointer<vtkCallbackCommand>::New();
-	vtk->_win->Internals->Interactor->CreateRepeatingTimer(10);
-	vtk->_timercb->SetCallback([](vtkObject*, unsigned long, void* clientData, void*) {
+	// Report the frame time, submitted triangles and culled props measured by the renderer,
+	// the frames dropped by the real-time animation playback and the scheduler wakeups
+	vtk->_rendercb = vtkSmartPointer<vtkCallbackCommand>::New();
+	vtk->_rendercb->SetCallback([](vtkObject*, unsigned long, void* clientData, void*) {
 		Data* vtk = static_cast<Data*>(clientData);
-		if (vtk->_scene->Internals->AnimationManager.IsPlaying()) {
-			vtk->_scene->Internals->AnimationManager.Tick();
-		}
+		Manager* manager = vtk->_vtkItem->_manager;
+		if (!manager || !vtk->_vtkItem->_options.ui.fps)
+			return;
+		vtkF3DRenderer* renderer = vtk->_win->Internals->Renderer;
+		double frameTime = renderer->GetFrameTime();
+		qint64 triangles = renderer->GetNumberOfSubmittedTriangles();
+		int visibleProps = renderer->GetNumberOfVisibleProps();
+		int culledProps = renderer->GetNumberOfCulledProps();
+		int droppedFrames = static_cast<int>(vtk->_scene->Internals->AnimationManager.GetNumberOfDroppedFrames());
+		QMetaObject::invokeMethod(manager, [=]() { emit manager->frameStats(frameTime, triangles, visibleProps, culledProps, droppedFrames, manager->_scheduler.wakeupsPerSecond()); },
+			Qt::QueuedConnection);
 		});
-	vtk->_win->Internals->Interactor->AddObserver(vtkCommand::TimerEvent, vtk->_timercb);
-	vtk->_timercb->SetClientData(vtk);
+	vtk->_rendercb->SetClientData(vtk);
+	renderWindow->AddObserver(vtkCommand::EndEvent, vtk->_rendercb);
 
 	vtk->_scene->Internals->AnimationManager.SetDeltaTime(1.0 / 30.0);
 	vtk->_win->UpdateDynamicOptions();
 	
 	_animanager = &vtk->_scene->Internals->AnimationManager;
+	_data = vtk;
 	return vtk;
 }
 
 void VtkItem::destroyingVTK(vtkRenderWindow* renderWindow, vtkUserData userData)
 {
+	// the worker must be done with the importers before the scene is deleted
+	cancelLoad();
+	if (_loadjob)
+		_loadjob->thread->wait();
 	_animanager = nullptr;
+	_data = nullptr;
 	_playf = false;
 	auto* vtk = Data::SafeDownCast(userData);
 
 	vtk->_scene->clear();
-	vtk->_timercb->Delete();
+	renderWindow->RemoveObserver(vtk->_rendercb);
 
 	delete vtk->_win;
 	vtk->_win = nullptr;
@@ -70,70 +145,325 @@ void VtkItem::destroyingVTK(vtkRenderWindow* renderWindow, vtkUserData userData)
 
 bool VtkItem::openSource(bool clear)
 {
-	dispatch_async([&](vtkRenderWindow* renderWindow, vtkUserData userData) {
-		bool ret = false;
+	if (_loadjob || !_data)
+		return false;
+
+	auto job = std::make_shared<LoadJob>();
+	job->fileName = _fname.toStdString();
+	job->clear = clear;
+	_loadjob = job;
+
+	// Parsing and conversion run on a worker thread, only actors creation and
+	// GPU upload happen on the render thread once it is done.
+	// The worker does not use the scene, importers are configured from a snapshot
+	f3d::detail::scene_impl::ImporterConfiguration config = _data->_scene->GetImporterConfiguration();
+	Manager* manager = _manager;
+	job->thread = QThread::create([job, config = std::move(config), manager]() {
+		vtkNew<vtkCallbackCommand> progressCallback;
+		progressCallback->SetClientData(manager);
+		progressCallback->SetCallback([](vtkObject*, unsigned long, void* clientData, void* callData) {
+			Manager* manager = static_cast<Manager*>(clientData);
+			double progress = *static_cast<double*>(callData);
+			QMetaObject::invokeMethod(manager, [manager, progress]() { emit manager->loadProgress(progress); },
+				Qt::QueuedConnection);
+			});
+
+		try {
+			std::vector<vtkSmartPointer<vtkImporter>> importers =
+				f3d::detail::scene_impl::CreateImporters({ job->fileName }, config);
+			{
+				std::lock_guard<std::mutex> lock(job->mutex);
+				job->importers = importers;
+			}
+			if (job->canceled)
+				return;
+
+			for (const auto& importer : importers) {
+				vtkF3DAssimpImporter* assimpImporter = vtkF3DAssimpImporter::SafeDownCast(importer);
+				if (assimpImporter) {
+					unsigned long observer = assimpImporter->AddObserver(vtkCommand::ProgressEvent, progressCallback);
+					bool ret = assimpImporter->Preload();
+					assimpImporter->RemoveObserver(observer);
+					if (!ret)
+						return;
+				}
+			}
+			job->preloaded = true;
+		}
+		catch (const std::exception& ex) {
+			qWarning() << "Unable to open" << QString::fromStdString(job->fileName) << ":" << ex.what();
+		}
+		});
+	connect(job->thread, &QThread::finished, this, [this, job]() {
+		job->thread->deleteLater();
+		finishLoad(job);
+		});
+	job->thread->start();
+	return true;
+}
+
+void VtkItem::cancelLoad()
+{
+	if (!_loadjob)
+		return;
+
+	_loadjob->canceled = true;
+	std::lock_guard<std::mutex> lock(_loadjob->mutex);
+	for (const auto& importer : _loadjob->importers) {
+		vtkF3DAssimpImporter* assimpImporter = vtkF3DAssimpImporter::SafeDownCast(importer);
+		if (assimpImporter)
+			assimpImporter->AbortImport();
+	}
+}
+
+void VtkItem::finishLoad(std::shared_ptr<LoadJob> job)
+{
+	if (_loadjob == job)
+		_loadjob.reset();
+
+	if (job->canceled || !_data) {
+		emit _manager->loadCanceled();
+		return;
+	}
+	if (!job->preloaded) {
+		emit _manager->loadFinished(false);
+		return;
+	}
+
+	// the scene graph of the loaded file is taken on the render thread, nullopt on failure
+	using SceneGraphPtr = std::shared_ptr<const vtkF3DAssimpImporter::SceneGraph>;
+	command<std::optional<SceneGraphPtr>>(Command::Load, [this, job](vtkRenderWindow* renderWindow, Data* vtk) {
+		std::optional<SceneGraphPtr> ret;
 		_playf = false;
 		_animanager->StopAnimation();
-		Data* vtk = (Data*)userData.GetPointer();
 		if (renderWindow->IsCurrent())
 		{
-			if (clear)
-				vtk->_scene->clear();
-			vtk->_scene->add(vtk->_vtkItem->_fname.toStdString());
-			vtk->_win->getCamera().resetToBounds();
-			ret = vtk->_win->render();
+			try {
+				if (job->clear)
+					vtk->_scene->clear();
+				vtk->_scene->add(job->importers);
+				vtk->_win->getCamera().resetToBounds();
+				_playf = _animanager->IsPlaying(); // autoplay
 
-			setTreeView(vtk, clear);
+				ret = SceneGraphPtr();
+				for (const auto& importer : job->importers) {
+					if (auto assimpImporter = vtkF3DAssimpImporter::SafeDownCast(importer))
+						ret = assimpImporter->GetSceneGraph();
+				}
+			}
+			catch (const std::exception& ex) {
+				qWarning() << "Unable to load" << QString::fromStdString(job->fileName) << ":" << ex.what();
+			}
 		}
+
 		return ret;
-		});
-	QThread::msleep(10);
-	return false;
+		}).then(this, [this, clear = job->clear](std::optional<SceneGraphPtr> graph) {
+			// the tree model belongs to the GUI thread, a file added without a scene graph
+			// keeps the tree of the previous ones
+			_manager->_scheduler.requestFrame(FrameScheduler::Scene);
+			_manager->_scheduler.setAnimating(_playf);
+			if (graph && (*graph || clear))
+				setTreeView(std::move(*graph));
+			emit _manager->loadFinished(graph.has_value());
+			});
 }
 
-void VtkItem::setTreeView(Data* vtk, bool clear)
+void VtkItem::setTreeView(std::shared_ptr<const vtkF3DAssimpImporter::SceneGraph> graph)
 {
-	vtkF3DAssimpImporter* importer = reinterpret_cast<vtkF3DAssimpImporter*>(
-		vtk->_scene->Internals->MetaImporter->Pimpl->Importers[0].Importer.Get());
-	_aiscene = importer->Internals->Scene;
-
-	_manager->setTreeModel(importer, clear);
+	_scenegraph = std::move(graph);
+	_manager->setTreeModel();
 }
 
 void VtkItem::close()
 {
-	dispatch_async([&](vtkRenderWindow* renderWindow, vtkUserData userData) {
-		Data* vtk = (Data*)userData.GetPointer();
+	command<void>(Command::Close, [this](vtkRenderWindow* renderWindow, Data* vtk) {
 		_playf = false;
 		_animanager->StopAnimation();
 		vtk->_scene->clear();
-		renderWindow->Render();
-		});
-	QThread::msleep(10);
+		}).then(this, [this]() { _manager->_scheduler.requestFrame(FrameScheduler::Scene); });
 }
 
 void VtkItem::play()
 {
-	dispatch_async([&](vtkRenderWindow* renderWindow, vtkUserData userData) {
-		Data* vtk = (Data*)userData.GetPointer();		
+	command<bool>(Command::Play, [this](vtkRenderWindow* renderWindow, Data* vtk) {
 		_animanager->ToggleAnimation();
 		_playf = _animanager->IsPlaying();
-		});	
-	QThread::msleep(10);
+		return _playf;
+		}).then(this, [this](bool playing) { _manager->_scheduler.setAnimating(playing); });
 }
 
 void VtkItem::sliderMove()
 {
-	dispatch_async([&](vtkRenderWindow* renderWindow, vtkUserData userData) {
-		Data* vtk = (Data*)userData.GetPointer();
+	// Moves received while a seek is queued replace it, only the latest value is loaded
+	command<void>(Command::Seek, [this, val = _manager->_sliderval](vtkRenderWindow* renderWindow, Data* vtk) {
 		if (_playf) {
 			_playf = false;
 			_animanager->StopAnimation();
 		}
 		double d = _animanager->TimeRange[1] - _animanager->TimeRange[0];
-		_animanager->LoadAtTime(_manager->_sliderval * d);
+		_animanager->SeekAtTime(val * d);
 		});
-	QThread::msleep(10);
+}
+
+void VtkItem::runCommand(Command id, vtkRenderWindow* renderWindow, Data* vtk)
+{
+	std::function<void(vtkRenderWindow*, Data*)> run;
+	QElapsedTimer submitted;
+	{
+		std::lock_guard<std::mutex> lock(_commandmutex);
+		QueuedCommand& queued = _commands[static_cast<size_t>(id)];
+		run = std::move(queued.run);
+		submitted = queued.submitted;
+		queued.promise.reset();
+		queued.queued = false;
+	}
+	run(renderWindow, vtk);
+	recordLatency(submitted.elapsed());
+}
+
+void VtkItem::recordLatency(qint64 ms)
+{
+	int bucket = 0;
+	while (bucket < LatencyBuckets - 1 && ms >= (qint64(1) << bucket))
+		bucket++;
+	_latencies[bucket]++;
+}
+
+void VtkItem::post(std::function<void(vtkRenderWindow*, Data*)> fn)
+{
+	if (_renderthread) {
+		_renderthread->post([fn = std::move(fn)](vtkRenderWindow* renderWindow, vtkObject* userData) {
+			fn(renderWindow, static_cast<Data*>(userData));
+			});
+	}
+	else {
+		dispatch_async([fn = std::move(fn)](vtkRenderWindow* renderWindow, vtkUserData userData) {
+			fn(renderWindow, static_cast<Data*>(userData.GetPointer()));
+			});
+	}
+}
+
+void VtkItem::requestRender()
+{
+	if (_renderthread)
+		post([](vtkRenderWindow* renderWindow, Data* vtk) {});
+	else
+		update();
+}
+
+void VtkItem::setThreadedRendering(bool threaded)
+{
+	if (threaded == threadedRendering())
+		return;
+	if (_data || (_renderthread && _renderthread->isStarted())) {
+		qWarning() << "The rendering mode cannot be changed once the item was rendered";
+		return;
+	}
+	if (!threaded) {
+		_renderthread.reset();
+		return;
+	}
+
+	_renderthread = std::make_unique<RenderThread>(QGuiApplication::primaryScreen(),
+		[this](vtkRenderWindow* renderWindow) -> vtkSmartPointer<vtkObject> { return initializeVTK(renderWindow); },
+		[this](vtkRenderWindow* renderWindow, vtkObject* userData) {
+			destroyingVTK(renderWindow, userData);
+			_adapter.reset();
+		});
+	connect(_renderthread.get(), &RenderThread::frameReady, this, [this]() { update(); }, Qt::QueuedConnection);
+}
+
+QSGNode* VtkItem::updatePaintNode(QSGNode* node, UpdatePaintNodeData* data)
+{
+	if (!_renderthread)
+		return QQuickVTKItem::updatePaintNode(node, data);
+
+	if (!_renderthread->isStarted()) {
+		auto* context = static_cast<QOpenGLContext*>(window()->rendererInterface()->getResource(
+			window(), QSGRendererInterface::OpenGLContextResource));
+		if (!context) {
+			qWarning() << "Threaded rendering needs the OpenGL scene graph backend";
+			return node;
+		}
+		_renderthread->start(context, (size() * window()->effectiveDevicePixelRatio()).toSize());
+	}
+
+	// display the latest finished frame, the render thread keeps drawing the next one
+	QSize frameSize;
+	int slot = 0;
+	unsigned int texture = _renderthread->acquireFrame(frameSize, slot);
+	if (!texture) {
+		delete node;
+		return nullptr;
+	}
+
+	auto* frameNode = static_cast<FrameNode*>(node);
+	if (!frameNode) {
+		frameNode = new FrameNode();
+		frameNode->setTextureCoordinatesTransform(QSGSimpleTextureNode::MirrorVertically);
+	}
+	// the framebuffer of a slot only changes on resize, its texture is wrapped again then
+	FrameNode::SlotTexture& wrapped = frameNode->textures[slot];
+	if (!wrapped.texture || wrapped.id != texture || wrapped.size != frameSize) {
+		wrapped.texture.reset(QNativeInterface::QSGOpenGLTexture::fromNative(texture, window(), frameSize));
+		wrapped.id = texture;
+		wrapped.size = frameSize;
+	}
+	if (frameNode->texture() != wrapped.texture.get())
+		frameNode->setTexture(wrapped.texture.get());
+	frameNode->setRect(boundingRect());
+	return frameNode;
+}
+
+bool VtkItem::event(QEvent* event)
+{
+	if (!_renderthread)
+		return QQuickVTKItem::event(event);
+
+	switch (event->type()) {
+	case QEvent::MouseButtonPress:
+	case QEvent::MouseButtonRelease:
+	case QEvent::MouseButtonDblClick:
+	case QEvent::MouseMove:
+	case QEvent::HoverEnter:
+	case QEvent::HoverLeave:
+	case QEvent::HoverMove:
+	case QEvent::Wheel:
+	case QEvent::KeyPress:
+	case QEvent::KeyRelease:
+	{
+		// the event is processed later on the render thread, it needs its own copy
+		if (event->type() == QEvent::MouseButtonPress)
+			forceActiveFocus(Qt::MouseFocusReason);
+		std::shared_ptr<QEvent> copy(event->clone());
+		qreal ratio = window() ? window()->effectiveDevicePixelRatio() : 1;
+		post([this, copy, ratio](vtkRenderWindow* renderWindow, Data* vtk) {
+			if (!_adapter)
+				_adapter = std::make_unique<QVTKInteractorAdapter>();
+			_adapter->SetDevicePixelRatio(ratio);
+			_adapter->ProcessEvent(copy.get(), renderWindow->GetInteractor());
+			});
+		event->accept();
+		return true;
+	}
+	default:
+		return QQuickVTKItem::event(event);
+	}
+}
+
+void VtkItem::geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry)
+{
+	QQuickVTKItem::geometryChange(newGeometry, oldGeometry);
+	if (_renderthread && window())
+		_renderthread->resize((newGeometry.size() * window()->effectiveDevicePixelRatio()).toSize());
+}
+
+std::array<int, VtkItem::LatencyBuckets> VtkItem::commandLatencies() const
+{
+	std::array<int, LatencyBuckets> latencies;
+	for (int i = 0; i < LatencyBuckets; i++)
+		latencies[i] = _latencies[i];
+	return latencies;
 }
 
 }
@@ -1,7 +1,11 @@
 #pragma once
 
 #include <QQuickVTKItem.h>
+#include <QVTKInteractorAdapter.h>
 
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QPromise>
 #include <QString>
 #include <QStandardItem>
 #include <QTreeView>
@@ -24,15 +28,29 @@
 #include "window_impl.h"
 #include "scene_impl.h"
 #include "options.h"
+#include "renderthread.h"
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
 
-class aiNode;
 namespace DS
 {
 class Manager;
 struct VtkItem : QQuickVTKItem
 {
 	Q_OBJECT
+	// Render VTK on a dedicated thread into offscreen framebuffers, instead of the scene
+	// graph render thread, so a slow frame does not stall the UI. Must be set before the
+	// item is first rendered, and needs the OpenGL scene graph backend
+	Q_PROPERTY(bool threadedRendering READ threadedRendering WRITE setThreadedRendering)
 public:
+	~VtkItem() override;
+
 	struct Data : vtkObject
 	{
 		static Data* New();
@@ -42,26 +60,121 @@ public:
 		f3d::detail::window_impl* _win = nullptr;
 		f3d::detail::scene_impl* _scene = nullptr;
 
-		vtkSmartPointer<vtkCallbackCommand> _timercb;
+		vtkSmartPointer<vtkCallbackCommand> _rendercb;
 	};
+	struct LoadJob;
+
+	// Operations run on the render thread. Queued commands of the same kind are coalesced:
+	// only the latest one runs and all callers get its result, except for Load and Play
+	enum class Command { Load, Close, Play, Seek, Tick, CameraReset, ShowAxis, Count };
+	static bool coalesces(Command id) { return id != Command::Load && id != Command::Play; }
+
+	// Bucket i counts the command round trips, from submission to completion on the render
+	// thread, shorter than 2^i ms, the last bucket counts all the longer ones
+	static constexpr int LatencyBuckets = 12;
+
 	QString _fname;
 	f3d::options _options;
+	Data*							_data = nullptr;
+	std::shared_ptr<LoadJob>		_loadjob;
 
 	Manager*						_manager = nullptr;
-    bool							_playf = false;
+	std::atomic<bool>				_playf = false; // written on the render thread
 	f3d::detail::animationManager*	_animanager = nullptr;
-	const aiScene*					_aiscene = nullptr;
+	std::shared_ptr<const vtkF3DAssimpImporter::SceneGraph> _scenegraph;
 
 	vtkUserData initializeVTK(vtkRenderWindow* renderWindow) override;
 	void destroyingVTK(vtkRenderWindow* renderWindow, vtkUserData userData) override;
 
 	bool openSource(bool clear);
+	void cancelLoad();
+	void finishLoad(std::shared_ptr<LoadJob> job);
 	void close();
 	void play();
 	void setupOpt();
-	void setTreeView(Data* vtk, bool clear);
-	void traversTree(QStandardItem* parent, const aiNode* node);
-	void timerCall();
+	void setTreeView(std::shared_ptr<const vtkF3DAssimpImporter::SceneGraph> graph);
+	QFuture<std::optional<double>> tick();
 	void sliderMove();
+
+	bool threadedRendering() const { return _renderthread != nullptr; }
+	void setThreadedRendering(bool threaded);
+	// Render a frame, whatever the rendering mode
+	void requestRender();
+
+	template <typename T>
+	QFuture<T> command(Command id, std::function<T(vtkRenderWindow*, Data*)> fn);
+	std::array<int, LatencyBuckets> commandLatencies() const;
+
+protected:
+	QSGNode* updatePaintNode(QSGNode* node, UpdatePaintNodeData* data) override;
+	bool event(QEvent* event) override;
+	void geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) override;
+
+private:
+	struct QueuedCommand
+	{
+		std::shared_ptr<void> promise; // QPromise of the command result type
+		std::function<void(vtkRenderWindow*, Data*)> run;
+		QElapsedTimer submitted;
+		bool queued = false;
+	};
+	void post(std::function<void(vtkRenderWindow*, Data*)> fn);
+	void runCommand(Command id, vtkRenderWindow* renderWindow, Data* vtk);
+	void recordLatency(qint64 ms);
+
+	std::mutex _commandmutex;
+	std::array<QueuedCommand, static_cast<size_t>(Command::Count)> _commands;
+	std::array<std::atomic<int>, LatencyBuckets> _latencies = {};
+
+	std::unique_ptr<RenderThread>	_renderthread;
+	std::unique_ptr<QVTKInteractorAdapter> _adapter; // created and used on the render thread
 };
+
+template <typename T>
+QFuture<T> VtkItem::command(Command id, std::function<T(vtkRenderWindow*, Data*)> fn)
+{
+	std::lock_guard<std::mutex> lock(_commandmutex);
+	QueuedCommand& queued = _commands[static_cast<size_t>(id)];
+	bool coalesced = queued.queued && coalesces(id);
+
+	std::shared_ptr<QPromise<T>> promise;
+	if (coalesced)
+		promise = std::static_pointer_cast<QPromise<T>>(queued.promise);
+	else {
+		promise = std::make_shared<QPromise<T>>();
+		promise->start();
+	}
+	auto run = [promise, fn = std::move(fn)](vtkRenderWindow* renderWindow, Data* vtk) {
+		if constexpr (std::is_void_v<T>)
+			fn(renderWindow, vtk);
+		else
+			promise->addResult(fn(renderWindow, vtk));
+		promise->finish();
+		};
+
+	if (coalesced) {
+		// the queued dispatch runs the latest function
+		queued.run = std::move(run);
+		return promise->future();
+	}
+
+	if (!coalesces(id)) {
+		QElapsedTimer submitted;
+		submitted.start();
+		post([this, run = std::move(run), submitted](vtkRenderWindow* renderWindow, Data* vtk) {
+			run(renderWindow, vtk);
+			recordLatency(submitted.elapsed());
+			});
+		return promise->future();
+	}
+
+	queued.promise = promise;
+	queued.run = std::move(run);
+	queued.submitted.start();
+	queued.queued = true;
+	post([this, id](vtkRenderWindow* renderWindow, Data* vtk) {
+		runCommand(id, renderWindow, vtk);
+		});
+	return promise->future();
+}
 }